@@ -0,0 +1,415 @@
+/* alphabetClasses.h
+ * Partição do alfabeto de um autômato em classes de símbolos
+ * equivalentes.
+ *
+ * Dois símbolos são equivalentes num autômato se nenhuma transição os
+ * distingue: para todo estado q, delta( q, a ) e delta( q, b ) são
+ * iguais (ou ambos indefinidos). Com alfabetos de bytes, em geral há
+ * poucas classes; por exemplo, em (a|b)*abb, os símbolos a e b formam
+ * duas classes, e todos os demais bytes são indefinidos.
+ *
+ * Reescrever o autômato sobre as classes (compressAlphabet) reduz o
+ * custo de todos os algoritmos que percorrem o alfabeto; o autômato
+ * original é obtido de volta com expandAlphabet. ByteClassDFA usa as
+ * classes para construir uma tabela de transições com uma coluna por
+ * classe, em vez de uma por byte.
+ */
+#ifndef ALPHABET_CLASSES_H
+#define ALPHABET_CLASSES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "epsilon.h"
+#include "automaton/deterministic.h"
+#include "automaton/nonDeterministic.h"
+#include "automaton/nonDeterministicWithEpsilon.h"
+#include "utility/either.h"
+
+/* Partição do alfabeto.
+ * As classes são numeradas de 0 a size()-1, na ordem do menor
+ * símbolo de cada classe. */
+template< typename Symbol >
+struct SymbolClasses {
+    std::map< Symbol, int > classOf;
+    std::vector< Symbol > representatives; // Menor símbolo de cada classe
+
+    std::size_t size() const { return representatives.size(); }
+};
+
+/* Calcula as classes de símbolos equivalentes do autômato passado.
+ * Em NFAe, as transições-épsilon não distinguem símbolos. */
+template< typename State, typename Symbol >
+SymbolClasses< Symbol > symbolClasses( const DFA< State, Symbol >& );
+template< typename State, typename Symbol >
+SymbolClasses< Symbol > symbolClasses( const NFA< State, Symbol >& );
+template< typename State, typename Symbol >
+SymbolClasses< Symbol > symbolClasses( const NFAe< State, Symbol >& );
+
+/* Função auxiliar, que faz o trabalho de symbolClasses.
+ *
+ * target[q*k + a] identifica o destino da transição do estado q pelo
+ * símbolo a, para 0 <= a < k; dois símbolos são equivalentes se suas
+ * colunas forem iguais. O retorno associa cada símbolo à sua classe;
+ * as classes são numeradas na ordem do seu menor símbolo. */
+inline std::vector< int > partitionColumns( const std::vector< int >& target,
+                                            std::size_t k );
+
+/* Reescreve o autômato sobre as classes passadas: o símbolo c do
+ * autômato retornado corresponde à classe c. As transições de cada
+ * classe são as do seu representante. */
+template< typename State, typename Symbol >
+DFA< State, int > compressAlphabet( const DFA< State, Symbol >&,
+                                    const SymbolClasses< Symbol >& );
+template< typename State, typename Symbol >
+NFA< State, int > compressAlphabet( const NFA< State, Symbol >&,
+                                    const SymbolClasses< Symbol >& );
+template< typename State, typename Symbol >
+NFAe< State, int > compressAlphabet( const NFAe< State, Symbol >&,
+                                     const SymbolClasses< Symbol >& );
+
+/* Operação inversa de compressAlphabet: cada transição por uma
+ * classe é replicada para todos os símbolos da classe. */
+template< typename State, typename Symbol >
+DFA< State, Symbol > expandAlphabet( const DFA< State, int >&,
+                                     const SymbolClasses< Symbol >& );
+template< typename State, typename Symbol >
+NFA< State, Symbol > expandAlphabet( const NFA< State, int >&,
+                                     const SymbolClasses< Symbol >& );
+template< typename State, typename Symbol >
+NFAe< State, Symbol > expandAlphabet( const NFAe< State, int >&,
+                                      const SymbolClasses< Symbol >& );
+
+/* Versão de DenseDFA (veja automaton/dense.h) cujas linhas possuem
+ * uma entrada por classe de bytes, em vez de uma entrada por byte.
+ * Cada transição custa um acesso a mais (ao mapa de classes), mas a
+ * tabela fica muito menor, o que importa em autômatos grandes.
+ *
+ * Os bytes fora do alfabeto formam uma classe própria, que leva sempre
+ * ao estado morto. */
+template< typename Symbol >
+class ByteClassDFA {
+    static_assert( sizeof(Symbol) == 1,
+        "ByteClassDFA supports only byte-sized symbols" );
+
+public:
+    typedef std::uint32_t State;
+
+    /* Como em DenseDFA, os estados são representados pelo deslocamento
+     * da sua linha na tabela, e o estado morto ocupa a linha 0. */
+    static constexpr State dead = 0;
+
+    /* Compila o autômato passado.
+     * O autômato deve ser compacto (veja automaton/compaction.h);
+     * caso contrário, std::domain_error é lançado. */
+    explicit ByteClassDFA( const DFA< int, Symbol >& );
+
+    /* Determina se o autômato aceita ou não a palavra delimitada
+     * pelo intervalo [begin, end). */
+    template< typename ForwardIterator >
+    bool accepts( ForwardIterator begin, ForwardIterator end ) const;
+
+    /* Estado inicial, transição e teste de estado final. */
+    State initialState() const;
+    State next( State q, Symbol a ) const;
+    bool isFinal( State q ) const;
+
+    /* Quantidade de estados, incluindo o estado morto, e
+     * quantidade de classes (colunas da tabela). */
+    std::size_t size() const;
+    std::size_t classes() const;
+
+private:
+    std::uint16_t byteClass[256];
+    unsigned rowSize;
+    std::vector< State > table; // table[q + byteClass[a]]
+    std::vector< std::uint64_t > finalStates; // Mapa de bits
+    State initial;
+};
+
+// Implementação
+
+inline std::vector< int > partitionColumns( const std::vector< int >& target,
+                                            std::size_t k )
+{
+    /* Refinamento: começamos com todos os símbolos numa mesma classe;
+     * cada estado separa os símbolos da mesma classe cujas transições
+     * levam a destinos diferentes. */
+    std::vector< int > cls( k, 0 );
+    std::size_t n = k == 0 ? 0 : target.size() / k;
+    std::size_t count = k > 0;
+    for( std::size_t q = 0; q < n && count < k; ++q ) {
+        std::map< std::pair< int, int >, int > refined;
+        for( std::size_t a = 0; a < k; ++a ) {
+            auto key = std::make_pair( cls[a], target[q * k + a] );
+            cls[a] = refined.insert({ key, (int) refined.size() })
+                        .first->second;
+        }
+        count = refined.size();
+    }
+    return cls;
+}
+
+/* Monta o objeto SymbolClasses a partir do retorno de partitionColumns,
+ * que já numera as classes na ordem do menor símbolo. */
+template< typename Symbol >
+SymbolClasses< Symbol > makeSymbolClasses( const std::set< Symbol >& alphabet,
+                                           const std::vector< int >& cls )
+{
+    SymbolClasses< Symbol > r;
+    std::size_t a = 0;
+    for( const Symbol& s : alphabet ) {
+        r.classOf.insert( r.classOf.end(), {s, cls[a]} );
+        if( cls[a] == (int) r.representatives.size() )
+            r.representatives.push_back( s );
+        ++a;
+    }
+    return r;
+}
+
+template< typename State, typename Symbol >
+SymbolClasses< Symbol > symbolClasses( const DFA< State, Symbol >& dfa ) {
+    std::map< State, int > index;
+    for( const State& q : dfa.states )
+        index.insert( index.end(), {q, (int) index.size()} );
+
+    std::size_t k = dfa.alphabet.size();
+    std::vector< int > target;
+    for( const State& q : dfa.states )
+        for( const Symbol& a : dfa.alphabet )
+            target.push_back( dfa.delta.onDomain({q, a}) ?
+                              index.at( dfa.delta({q, a}) ) : -1 );
+    return makeSymbolClasses( dfa.alphabet, partitionColumns( target, k ) );
+}
+
+template< typename State, typename Symbol >
+SymbolClasses< Symbol > symbolClasses( const NFA< State, Symbol >& nfa ) {
+    // Cada conjunto de destinos distinto recebe um número.
+    std::map< std::set< State >, int > index;
+    index[std::set< State >()] = -1;
+
+    std::size_t k = nfa.alphabet.size();
+    std::vector< int > target;
+    for( const State& q : nfa.states )
+        for( const Symbol& a : nfa.alphabet ) {
+            if( !nfa.delta.onDomain({q, a}) ) {
+                target.push_back( -1 );
+                continue;
+            }
+            const std::set< State >& s = nfa.delta({q, a});
+            target.push_back( index.insert({ s, (int) index.size() })
+                                .first->second );
+        }
+    return makeSymbolClasses( nfa.alphabet, partitionColumns( target, k ) );
+}
+
+template< typename State, typename Symbol >
+SymbolClasses< Symbol > symbolClasses( const NFAe< State, Symbol >& nfae ) {
+    std::map< std::set< State >, int > index;
+    index[std::set< State >()] = -1;
+
+    std::size_t k = nfae.alphabet.size();
+    std::vector< int > target;
+    for( const State& q : nfae.states )
+        for( const Symbol& a : nfae.alphabet ) {
+            if( !nfae.delta.onDomain({q, a}) ) {
+                target.push_back( -1 );
+                continue;
+            }
+            const std::set< State >& s = nfae.delta({q, a});
+            target.push_back( index.insert({ s, (int) index.size() })
+                                .first->second );
+        }
+    return makeSymbolClasses( nfae.alphabet, partitionColumns( target, k ) );
+}
+
+template< typename State, typename Symbol >
+DFA< State, int > compressAlphabet( const DFA< State, Symbol >& dfa,
+                                    const SymbolClasses< Symbol >& classes )
+{
+    DFA< State, int > r;
+    r.states = dfa.states;
+    for( std::size_t c = 0; c < classes.size(); ++c )
+        r.alphabet.insert( r.alphabet.end(), c );
+    for( const State& q : dfa.states )
+        for( std::size_t c = 0; c < classes.size(); ++c )
+            if( dfa.delta.onDomain({q, classes.representatives[c]}) )
+                r.delta.insert( {q, (int) c},
+                                dfa.delta({q, classes.representatives[c]}) );
+    r.initialState = dfa.initialState;
+    r.finalStates = dfa.finalStates;
+    return r;
+}
+
+template< typename State, typename Symbol >
+NFA< State, int > compressAlphabet( const NFA< State, Symbol >& nfa,
+                                    const SymbolClasses< Symbol >& classes )
+{
+    NFA< State, int > r;
+    r.states = nfa.states;
+    for( std::size_t c = 0; c < classes.size(); ++c )
+        r.alphabet.insert( r.alphabet.end(), c );
+    for( const State& q : nfa.states )
+        for( std::size_t c = 0; c < classes.size(); ++c )
+            if( nfa.delta.onDomain({q, classes.representatives[c]}) )
+                r.delta.insert( {q, (int) c},
+                                nfa.delta({q, classes.representatives[c]}) );
+    r.initialState = nfa.initialState;
+    r.finalStates = nfa.finalStates;
+    return r;
+}
+
+template< typename State, typename Symbol >
+NFAe< State, int > compressAlphabet( const NFAe< State, Symbol >& nfae,
+                                     const SymbolClasses< Symbol >& classes )
+{
+    NFAe< State, int > r;
+    r.states = nfae.states;
+    for( std::size_t c = 0; c < classes.size(); ++c )
+        r.alphabet.insert( r.alphabet.end(), c );
+    for( const State& q : nfae.states ) {
+        for( std::size_t c = 0; c < classes.size(); ++c )
+            if( nfae.delta.onDomain({q, classes.representatives[c]}) )
+                r.delta.insert( {q, (int) c},
+                                nfae.delta({q, classes.representatives[c]}) );
+        if( nfae.delta.onDomain({q, epsilon}) )
+            r.delta.insert( {q, epsilon}, nfae.delta({q, epsilon}) );
+    }
+    r.initialState = nfae.initialState;
+    r.finalStates = nfae.finalStates;
+    return r;
+}
+
+template< typename State, typename Symbol >
+DFA< State, Symbol > expandAlphabet( const DFA< State, int >& dfa,
+                                     const SymbolClasses< Symbol >& classes )
+{
+    DFA< State, Symbol > r;
+    r.states = dfa.states;
+    for( const auto& pair : classes.classOf )
+        r.alphabet.insert( r.alphabet.end(), pair.first );
+    for( const State& q : dfa.states )
+        for( const auto& pair : classes.classOf )
+            if( dfa.delta.onDomain({q, pair.second}) )
+                r.delta.insert( {q, pair.first},
+                                dfa.delta({q, pair.second}) );
+    r.initialState = dfa.initialState;
+    r.finalStates = dfa.finalStates;
+    return r;
+}
+
+template< typename State, typename Symbol >
+NFA< State, Symbol > expandAlphabet( const NFA< State, int >& nfa,
+                                     const SymbolClasses< Symbol >& classes )
+{
+    NFA< State, Symbol > r;
+    r.states = nfa.states;
+    for( const auto& pair : classes.classOf )
+        r.alphabet.insert( r.alphabet.end(), pair.first );
+    for( const State& q : nfa.states )
+        for( const auto& pair : classes.classOf )
+            if( nfa.delta.onDomain({q, pair.second}) )
+                r.delta.insert( {q, pair.first},
+                                nfa.delta({q, pair.second}) );
+    r.initialState = nfa.initialState;
+    r.finalStates = nfa.finalStates;
+    return r;
+}
+
+template< typename State, typename Symbol >
+NFAe< State, Symbol > expandAlphabet( const NFAe< State, int >& nfae,
+                                      const SymbolClasses< Symbol >& classes )
+{
+    NFAe< State, Symbol > r;
+    r.states = nfae.states;
+    for( const auto& pair : classes.classOf )
+        r.alphabet.insert( r.alphabet.end(), pair.first );
+    for( const State& q : nfae.states ) {
+        for( const auto& pair : classes.classOf )
+            if( nfae.delta.onDomain({q, pair.second}) )
+                r.delta.insert( {q, pair.first},
+                                nfae.delta({q, pair.second}) );
+        if( nfae.delta.onDomain({q, epsilon}) )
+            r.delta.insert( {q, epsilon}, nfae.delta({q, epsilon}) );
+    }
+    r.initialState = nfae.initialState;
+    r.finalStates = nfae.finalStates;
+    return r;
+}
+
+template< typename Symbol >
+constexpr typename ByteClassDFA< Symbol >::State ByteClassDFA< Symbol >::dead;
+
+template< typename Symbol >
+ByteClassDFA< Symbol >::ByteClassDFA( const DFA< int, Symbol >& dfa ) {
+    std::size_t n = dfa.states.size();
+    if( n > 0 && ( *dfa.states.begin() != 0 ||
+                   *dfa.states.rbegin() != int(n - 1) ) )
+        throw std::domain_error( "Automaton is not compact." );
+
+    /* A classe 0 é reservada para os bytes fora do alfabeto; as classes
+     * do autômato são deslocadas em uma posição. Se o alfabeto cobrir
+     * todos os bytes, a classe 0 simplesmente não é usada. */
+    SymbolClasses< Symbol > classes = symbolClasses( dfa );
+    for( std::uint16_t& c : byteClass )
+        c = 0;
+    for( const auto& pair : classes.classOf )
+        byteClass[(unsigned char) pair.first] = pair.second + 1;
+    rowSize = classes.size() + 1;
+
+    table.assign( (n + 1) * rowSize, dead );
+    finalStates.assign( (n + 1 + 63) / 64, 0 );
+    for( int q = 0; q < (int) n; ++q )
+        for( std::size_t c = 0; c < classes.size(); ++c )
+            if( dfa.delta.onDomain({q, classes.representatives[c]}) )
+                table[(q + 1) * rowSize + c + 1] =
+                    (dfa.delta({q, classes.representatives[c]}) + 1) * rowSize;
+    for( int q : dfa.finalStates )
+        finalStates[(q + 1) / 64] |= std::uint64_t(1) << ((q + 1) % 64);
+
+    initial = n > 0 ? (dfa.initialState + 1) * rowSize : dead;
+}
+
+template< typename Symbol >
+template< typename ForwardIterator >
+bool ByteClassDFA< Symbol >::accepts( ForwardIterator begin,
+                                      ForwardIterator end ) const
+{
+    const State * t = table.data();
+    State q = initial;
+    for( ; begin != end; ++begin )
+        q = t[q + byteClass[(unsigned char) *begin]];
+    return isFinal( q );
+}
+
+template< typename Symbol >
+auto ByteClassDFA< Symbol >::initialState() const -> State {
+    return initial;
+}
+
+template< typename Symbol >
+auto ByteClassDFA< Symbol >::next( State q, Symbol a ) const -> State {
+    return table[q + byteClass[(unsigned char) a]];
+}
+
+template< typename Symbol >
+bool ByteClassDFA< Symbol >::isFinal( State q ) const {
+    q /= rowSize;
+    return (finalStates[q / 64] >> (q % 64)) & 1;
+}
+
+template< typename Symbol >
+std::size_t ByteClassDFA< Symbol >::size() const {
+    return table.size() / rowSize;
+}
+
+template< typename Symbol >
+std::size_t ByteClassDFA< Symbol >::classes() const {
+    return rowSize;
+}
+
+#endif // ALPHABET_CLASSES_H
@@ -0,0 +1,194 @@
+/* antichains.h
+ * Inclusão e universalidade de linguagens de autômatos não
+ * determinísticos pelo método das anticadeias (De Wulf, Doyen,
+ * Henzinger e Raskin), sem determinizar os autômatos.
+ *
+ * Para decidir se L(A) está contida em L(B), basta procurar uma palavra
+ * que leve A a um estado final e B a um conjunto de estados sem nenhum
+ * estado final. A busca percorre pares (p, S), em que p é um estado de
+ * A e S é o conjunto de estados de B alcançados pela mesma palavra; S é
+ * um estado do autômato de subconjuntos de B, mas apenas os pares
+ * alcançáveis são construídos.
+ *
+ * Além disso, se S está contido em S', qualquer palavra que, a partir
+ * de (p, S'), comprove a não inclusão também o faz a partir de (p, S).
+ * Assim, (p, S') pode ser descartado; os pares mantidos formam uma
+ * anticadeia, que costuma ser muito menor que o autômato de
+ * subconjuntos.
+ *
+ * A universalidade de L(B) é a inclusão de Σ* em L(B).
+ */
+#ifndef ANTICHAINS_H
+#define ANTICHAINS_H
+
+#include <set>
+#include <utility>
+#include <vector>
+#include "conversion.h"
+#include "automaton/nonDeterministic.h"
+#include "automaton/nonDeterministicWithEpsilon.h"
+#include "automaton/product.h"
+#include "automaton/successorTable.h"
+#include "utility/bitset.h"
+
+/* Determina se a linguagem do primeiro autômato está contida na
+ * linguagem do segundo.
+ *
+ * Caso não esteja, a versão com o parâmetro word armazena nele uma
+ * palavra aceita pelo primeiro autômato e rejeitada pelo segundo;
+ * caso contrário, word é esvaziado. Transições-épsilon são eliminadas
+ * com toNFA, que não aumenta a quantidade de estados. */
+template< typename State1, typename State2, typename Symbol >
+bool included( const NFA< State1, Symbol >&, const NFA< State2, Symbol >&,
+               std::vector< Symbol >& word );
+template< typename State1, typename State2, typename Symbol >
+bool included( const NFA< State1, Symbol >&, const NFA< State2, Symbol >& );
+template< typename State1, typename State2, typename Symbol >
+bool included( const NFAe< State1, Symbol >&, const NFAe< State2, Symbol >&,
+               std::vector< Symbol >& word );
+template< typename State1, typename State2, typename Symbol >
+bool included( const NFAe< State1, Symbol >&, const NFAe< State2, Symbol >& );
+
+/* Determina se o autômato aceita todas as palavras sobre o seu
+ * alfabeto. Caso não aceite, a versão com o parâmetro word armazena
+ * nele uma palavra rejeitada. */
+template< typename State, typename Symbol >
+bool universal( const NFA< State, Symbol >&, std::vector< Symbol >& word );
+template< typename State, typename Symbol >
+bool universal( const NFA< State, Symbol >& );
+template< typename State, typename Symbol >
+bool universal( const NFAe< State, Symbol >&, std::vector< Symbol >& word );
+template< typename State, typename Symbol >
+bool universal( const NFAe< State, Symbol >& );
+
+
+// Implementação
+template< typename State1, typename State2, typename Symbol >
+bool included( const NFA< State1, Symbol >& A, const NFA< State2, Symbol >& B,
+               std::vector< Symbol >& word )
+{
+    std::set< Symbol > alphabet = A.alphabet;
+    alphabet.insert( B.alphabet.begin(), B.alphabet.end() );
+    std::vector< Symbol > symbols( alphabet.begin(), alphabet.end() );
+    std::size_t k = symbols.size();
+    SuccessorTable< Symbol > a( A, symbols ), b( B, symbols );
+
+    /* Pares descobertos: p[i] e S[i] formam o i-ésimo par; parent[i] e
+     * via[i] são o par e o símbolo pelos quais ele foi descoberto.
+     * antichain[p] contém os pares vivos com primeiro elemento p; um par
+     * morre quando outro, com conjunto menor, é descoberto. */
+    std::vector< int > p, parent, via;
+    std::vector< Bitset > S;
+    std::vector< bool > alive;
+    std::vector< std::vector< int > > antichain( a.n );
+
+    word.clear();
+    auto discover = [&]( int q, Bitset s, int from, int symbol ) {
+        std::vector< int >& chain = antichain[q];
+        for( int i : chain )
+            if( S[i].isSubsetOf( s ) )
+                return false;
+        chain.erase( std::remove_if( chain.begin(), chain.end(),
+            [&]( int i ) {
+                if( !s.isSubsetOf( S[i] ) )
+                    return false;
+                alive[i] = false;
+                return true;
+            }), chain.end() );
+
+        chain.push_back( p.size() );
+        bool found = a.finalStates.test( q ) && !s.intersects( b.finalStates );
+        p.push_back( q );
+        S.push_back( std::move( s ) );
+        parent.push_back( from );
+        via.push_back( symbol );
+        alive.push_back( true );
+        if( !found )
+            return false;
+
+        reconstructWord( p.size() - 1, parent, via, symbols, word );
+        return true;
+    };
+
+    Bitset initial( b.n );
+    initial.set( b.initialState );
+    if( discover( a.initialState, initial, -1, -1 ) )
+        return false;
+
+    // Busca em largura; os pares mortos não são expandidos.
+    for( std::size_t i = 0; i < p.size(); ++i ) {
+        if( !alive[i] )
+            continue;
+        for( std::size_t c = 0; c < k; ++c ) {
+            const std::vector< int >& targets = a.next[p[i] * k + c];
+            if( targets.empty() )
+                continue;
+            Bitset s( b.n );
+            S[i].forEach( [&]( std::size_t q ) {
+                for( int r : b.next[q * k + c] )
+                    s.set( r );
+            });
+            for( int r : targets )
+                if( discover( r, s, i, c ) )
+                    return false;
+        }
+    }
+    return true;
+}
+
+template< typename State1, typename State2, typename Symbol >
+bool included( const NFA< State1, Symbol >& A, const NFA< State2, Symbol >& B )
+{
+    std::vector< Symbol > word;
+    return included( A, B, word );
+}
+
+template< typename State1, typename State2, typename Symbol >
+bool included( const NFAe< State1, Symbol >& A,
+               const NFAe< State2, Symbol >& B, std::vector< Symbol >& word )
+{
+    return included( toNFA( A ), toNFA( B ), word );
+}
+
+template< typename State1, typename State2, typename Symbol >
+bool included( const NFAe< State1, Symbol >& A,
+               const NFAe< State2, Symbol >& B )
+{
+    std::vector< Symbol > word;
+    return included( A, B, word );
+}
+
+template< typename State, typename Symbol >
+bool universal( const NFA< State, Symbol >& nfa, std::vector< Symbol >& word )
+{
+    // Autômato de um único estado, que aceita Σ*.
+    NFA< int, Symbol > sigmaStar;
+    sigmaStar.states = {0};
+    sigmaStar.alphabet = nfa.alphabet;
+    for( const Symbol& a : nfa.alphabet )
+        sigmaStar.delta.insert( {0, a}, {0} );
+    sigmaStar.initialState = 0;
+    sigmaStar.finalStates = {0};
+    return included( sigmaStar, nfa, word );
+}
+
+template< typename State, typename Symbol >
+bool universal( const NFA< State, Symbol >& nfa ) {
+    std::vector< Symbol > word;
+    return universal( nfa, word );
+}
+
+template< typename State, typename Symbol >
+bool universal( const NFAe< State, Symbol >& nfae,
+                std::vector< Symbol >& word )
+{
+    return universal( toNFA( nfae ), word );
+}
+
+template< typename State, typename Symbol >
+bool universal( const NFAe< State, Symbol >& nfae ) {
+    std::vector< Symbol > word;
+    return universal( nfae, word );
+}
+
+#endif // ANTICHAINS_H
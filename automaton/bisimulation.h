@@ -0,0 +1,168 @@
+/* bisimulation.h
+ * Equivalência de linguagens de autômatos não determinísticos por
+ * bisimulação a menos de congruência (algoritmo HKC, de Bonchi e Pous).
+ *
+ * Como no algoritmo de Hopcroft e Karp (veja equivalent, em
+ * automaton/decisionProcedures.h), a busca percorre pares de estados do
+ * autômato de subconjuntos, construídos sob demanda; aqui, porém, os
+ * estados são conjuntos de estados da união disjunta dos dois NFAs.
+ *
+ * Um par (X, Y) é ignorado se puder ser deduzido dos pares já aceitos
+ * pelas regras de congruência: reflexividade, simetria, transitividade
+ * e união (se X ~ Y e X' ~ Y', então X ∪ X' ~ Y ∪ Y'). Para isto,
+ * reescrevemos X: para cada par aceito (U, V), se U está contido em X,
+ * V é acrescentado a X, e vice-versa; (X, Y) é deduzível se e somente
+ * se X e Y possuírem a mesma forma normal. Em famílias como
+ * (a|b)*a(a|b)^n, cujo autômato de subconjuntos possui 2^(n+1) estados,
+ * a quantidade de pares visitados permanece polinomial.
+ */
+#ifndef BISIMULATION_H
+#define BISIMULATION_H
+
+#include <set>
+#include <vector>
+#include "conversion.h"
+#include "automaton/nonDeterministic.h"
+#include "automaton/nonDeterministicWithEpsilon.h"
+#include "automaton/product.h"
+#include "automaton/successorTable.h"
+#include "utility/bitset.h"
+
+/* Determina se os dois autômatos aceitam a mesma linguagem.
+ *
+ * Caso não aceitem, a versão com o parâmetro word armazena nele uma
+ * palavra aceita por exatamente um dos autômatos; caso contrário, word
+ * é esvaziado. Transições-épsilon são eliminadas com toNFA. */
+template< typename State1, typename State2, typename Symbol >
+bool equivalent( const NFA< State1, Symbol >&, const NFA< State2, Symbol >&,
+                 std::vector< Symbol >& word );
+template< typename State1, typename State2, typename Symbol >
+bool equivalent( const NFA< State1, Symbol >&, const NFA< State2, Symbol >& );
+template< typename State1, typename State2, typename Symbol >
+bool equivalent( const NFAe< State1, Symbol >&,
+                 const NFAe< State2, Symbol >&, std::vector< Symbol >& word );
+template< typename State1, typename State2, typename Symbol >
+bool equivalent( const NFAe< State1, Symbol >&,
+                 const NFAe< State2, Symbol >& );
+
+
+// Implementação
+template< typename State1, typename State2, typename Symbol >
+bool equivalent( const NFA< State1, Symbol >& A, const NFA< State2, Symbol >& B,
+                 std::vector< Symbol >& word )
+{
+    std::set< Symbol > alphabet = A.alphabet;
+    alphabet.insert( B.alphabet.begin(), B.alphabet.end() );
+    std::vector< Symbol > symbols( alphabet.begin(), alphabet.end() );
+    std::size_t k = symbols.size();
+    SuccessorTable< Symbol > a( A, symbols ), b( B, symbols );
+
+    /* União disjunta: os estados de B são deslocados de a.n. */
+    std::size_t n = a.n + b.n;
+    std::vector< std::vector< int > > next( a.next );
+    for( const std::vector< int >& v : b.next ) {
+        next.push_back( v );
+        for( int& r : next.back() )
+            r += a.n;
+    }
+    Bitset finalStates( n );
+    a.finalStates.forEach( [&]( std::size_t q ) { finalStates.set( q ); } );
+    b.finalStates.forEach( [&]( std::size_t q ) {
+        finalStates.set( a.n + q );
+    });
+
+    /* X[i] e Y[i] formam o i-ésimo par descoberto; parent[i] e via[i]
+     * são o par e o símbolo pelos quais ele foi descoberto. Os pares já
+     * aceitos (R) e os que ainda estão na fila (todo) servem de regras
+     * de reescrita; pruned[i] indica que o par i foi ignorado. */
+    std::vector< Bitset > X, Y;
+    std::vector< int > parent, via;
+    std::vector< bool > pruned;
+
+    /* Acrescenta a x os conjuntos exigidos pelas regras, exceto a regra
+     * skip, até que y esteja contido em x ou não haja mais mudanças.
+     * Retorna true no primeiro caso. */
+    auto rewrite = [&]( Bitset x, const Bitset& y, std::size_t skip ) {
+        bool changed = true;
+        while( changed && !y.isSubsetOf( x ) ) {
+            changed = false;
+            for( std::size_t j = 0; j < X.size(); ++j ) {
+                if( j == skip || pruned[j] )
+                    continue;
+                if( X[j].isSubsetOf( x ) && !Y[j].isSubsetOf( x ) ) {
+                    x |= Y[j];
+                    changed = true;
+                }
+                if( Y[j].isSubsetOf( x ) && !X[j].isSubsetOf( x ) ) {
+                    x |= X[j];
+                    changed = true;
+                }
+            }
+        }
+        return y.isSubsetOf( x );
+    };
+
+    auto push = [&]( Bitset x, Bitset y, int from, int symbol ) {
+        X.push_back( std::move( x ) );
+        Y.push_back( std::move( y ) );
+        parent.push_back( from );
+        via.push_back( symbol );
+        pruned.push_back( false );
+    };
+
+    Bitset x0( n ), y0( n );
+    x0.set( a.initialState );
+    y0.set( a.n + b.initialState );
+    push( x0, y0, -1, -1 );
+
+    word.clear();
+    for( std::size_t i = 0; i < X.size(); ++i ) {
+        if( rewrite( X[i], Y[i], i ) && rewrite( Y[i], X[i], i ) ) {
+            pruned[i] = true;
+            continue;
+        }
+        if( X[i].intersects( finalStates ) != Y[i].intersects( finalStates ) )
+        {
+            reconstructWord( i, parent, via, symbols, word );
+            return false;
+        }
+        for( std::size_t c = 0; c < k; ++c ) {
+            Bitset x( n ), y( n );
+            X[i].forEach( [&]( std::size_t q ) {
+                for( int r : next[q * k + c] )
+                    x.set( r );
+            });
+            Y[i].forEach( [&]( std::size_t q ) {
+                for( int r : next[q * k + c] )
+                    y.set( r );
+            });
+            push( std::move( x ), std::move( y ), i, c );
+        }
+    }
+    return true;
+}
+
+template< typename State1, typename State2, typename Symbol >
+bool equivalent( const NFA< State1, Symbol >& A,
+                 const NFA< State2, Symbol >& B )
+{
+    std::vector< Symbol > word;
+    return equivalent( A, B, word );
+}
+
+template< typename State1, typename State2, typename Symbol >
+bool equivalent( const NFAe< State1, Symbol >& A,
+                 const NFAe< State2, Symbol >& B, std::vector< Symbol >& word )
+{
+    return equivalent( toNFA( A ), toNFA( B ), word );
+}
+
+template< typename State1, typename State2, typename Symbol >
+bool equivalent( const NFAe< State1, Symbol >& A,
+                 const NFAe< State2, Symbol >& B )
+{
+    std::vector< Symbol > word;
+    return equivalent( A, B, word );
+}
+
+#endif // BISIMULATION_H
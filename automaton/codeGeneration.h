@@ -0,0 +1,191 @@
+/* codeGeneration.h
+ * Geração de código C++ especializado para reconhecer a linguagem de
+ * um DFA, como fazem geradores de analisadores léxicos (re2c, por
+ * exemplo).
+ *
+ * Mesmo em DenseDFA, cada símbolo custa um acesso indireto à tabela.
+ * generateMatcher escreve uma função em que cada estado é um rótulo,
+ * e cada transição, um goto; o símbolo lido é testado num switch e,
+ * para intervalos de símbolos com o mesmo destino (como 'a' a 'z'),
+ * num único if (c >= 'a' && c <= 'z', que o compilador reduz a uma
+ * comparação sem sinal). O compilador pode, então, manter o estado
+ * implicitamente no contador de programa.
+ *
+ * Estados que não alcançam nenhum estado final não são gerados: as
+ * transições para eles encerram a leitura, rejeitando a palavra.
+ *
+ * Apenas símbolos de um byte são suportados.
+ */
+#ifndef CODE_GENERATION_H
+#define CODE_GENERATION_H
+
+#include <cctype>
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "automaton/deterministic.h"
+
+/* Escreve em out a definição da função
+ *  inline bool name( const char * begin, const char * end );
+ * que retorna true se, e somente se, o autômato aceita a palavra
+ * delimitada pelo intervalo [begin, end). A função não depende de
+ * nenhum cabeçalho.
+ *
+ * O autômato deve ser compacto (veja automaton/compaction.h); caso
+ * contrário, std::domain_error é lançado. */
+template< typename Symbol >
+void generateMatcher( const DFA< int, Symbol >&, const std::string& name,
+                      std::ostream& out );
+
+/* Intervalos com pelo menos esta quantidade de símbolos são testados
+ * com uma comparação, em vez de um rótulo do switch por símbolo. */
+constexpr unsigned minimumRangeLength = 3;
+
+// Implementação
+
+/* Escreve o byte c como uma constante de caractere, se for imprimível,
+ * ou como um número. */
+inline std::string byteLiteral( unsigned c ) {
+    if( std::isalnum( c ) )
+        return std::string( "'" ) + char( c ) + "'";
+    return std::to_string( c );
+}
+
+template< typename Symbol >
+void generateMatcher( const DFA< int, Symbol >& dfa, const std::string& name,
+                      std::ostream& out )
+{
+    static_assert( sizeof(Symbol) == 1,
+        "generateMatcher supports only byte-sized symbols" );
+    std::size_t n = dfa.states.size();
+    if( n > 0 && ( *dfa.states.begin() != 0 ||
+                   *dfa.states.rbegin() != int(n - 1) ) )
+        throw std::domain_error( "Automaton is not compact." );
+
+    // target[q*256 + c] é o destino de q pelo byte c, ou -1.
+    std::vector< int > target( n * 256, -1 );
+    std::vector< std::vector< int > > predecessors( n );
+    for( const auto& pair : dfa.delta ) {
+        target[pair.first.first * 256 + (unsigned char) pair.first.second] =
+            pair.second;
+        predecessors[pair.second].push_back( pair.first.first );
+    }
+
+    /* Estados vivos: busca a partir dos estados finais, no grafo com as
+     * transições invertidas. As transições para os demais estados são
+     * tratadas como indefinidas. */
+    std::vector< bool > live( n, false );
+    std::vector< int > stack( dfa.finalStates.begin(), dfa.finalStates.end() );
+    for( int q : stack )
+        live[q] = true;
+    while( !stack.empty() ) {
+        int q = stack.back();
+        stack.pop_back();
+        for( int p : predecessors[q] )
+            if( !live[p] ) {
+                live[p] = true;
+                stack.push_back( p );
+            }
+    }
+    for( int& t : target )
+        if( t != -1 && !live[t] )
+            t = -1;
+
+    out << "inline bool " << name << "( const char * p, const char * end ) {\n";
+    if( n == 0 || !live[dfa.initialState] ) {
+        out << "    (void) p;\n    (void) end;\n    return false;\n}\n";
+        return;
+    }
+
+    /* Os estados são escritos na ordem em que são alcançados a partir do
+     * estado inicial; assim, o estado inicial vem primeiro e não precisa
+     * de um goto. Apenas os rótulos usados são escritos. */
+    std::vector< int > order( 1, dfa.initialState );
+    std::vector< bool > visited( n, false ), referenced( n, false );
+    std::vector< bool > reads( n, false ); // O estado possui transições
+    visited[dfa.initialState] = true;
+    for( std::size_t i = 0; i < order.size(); ++i )
+        for( unsigned c = 0; c < 256; ++c ) {
+            int r = target[order[i] * 256 + c];
+            if( r == -1 )
+                continue;
+            referenced[r] = true;
+            reads[order[i]] = true;
+            if( !visited[r] ) {
+                visited[r] = true;
+                order.push_back( r );
+            }
+        }
+
+    for( int q : order )
+        if( reads[q] ) {
+            out << "    unsigned c;\n";
+            break;
+        }
+    for( int q : order ) {
+        const int * row = &target[q * 256];
+        bool final = dfa.finalStates.count( q ) > 0;
+        if( referenced[q] )
+            out << "s" << q << ":\n";
+        if( !reads[q] ) { // Estado vivo sem transições, portanto final
+            out << "    return p == end;\n";
+            continue;
+        }
+        out << "    if( p == end )\n"
+            << "        return " << (final ? "true" : "false") << ";\n"
+            << "    c = (unsigned char) *p++;\n";
+
+        /* Divide os bytes em intervalos maximais com o mesmo destino;
+         * os intervalos curtos vão para o switch, agrupados por destino. */
+        std::map< int, std::vector< unsigned > > cases;
+        std::vector< unsigned > ranges; // Pares [início, fim]
+        for( unsigned c = 0; c < 256; ) {
+            unsigned e = c;
+            while( e + 1 < 256 && row[e + 1] == row[c] )
+                ++e;
+            if( row[c] != -1 ) {
+                if( e - c + 1 >= minimumRangeLength )
+                    ranges.insert( ranges.end(), {c, e} );
+                else
+                    for( unsigned d = c; d <= e; ++d )
+                        cases[row[c]].push_back( d );
+            }
+            c = e + 1;
+        }
+
+        if( !cases.empty() ) {
+            out << "    switch( c ) {\n";
+            for( const auto& pair : cases ) {
+                out << "       ";
+                for( unsigned d : pair.second )
+                    out << " case " << byteLiteral( d ) << ":";
+                out << " goto s" << pair.first << ";\n";
+            }
+            out << "    }\n";
+        }
+        for( std::size_t i = 0; i < ranges.size(); i += 2 ) {
+            unsigned first = ranges[i], last = ranges[i + 1];
+            int r = row[first];
+            if( first == 0 && last == 255 )
+                out << "    goto s" << r << ";\n";
+            else if( first == 0 )
+                out << "    if( c <= " << byteLiteral( last ) << " )\n"
+                    << "        goto s" << r << ";\n";
+            else if( last == 255 )
+                out << "    if( c >= " << byteLiteral( first ) << " )\n"
+                    << "        goto s" << r << ";\n";
+            else
+                out << "    if( c >= " << byteLiteral( first )
+                    << " && c <= " << byteLiteral( last ) << " )\n"
+                    << "        goto s" << r << ";\n";
+        }
+        if( ranges.size() != 2 || ranges[0] != 0 || ranges[1] != 255 )
+            out << "    return false;\n";
+    }
+    out << "}\n";
+}
+
+#endif // CODE_GENERATION_H
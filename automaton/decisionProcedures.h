@@ -7,10 +7,15 @@
 
 #include <map>
 #include <functional>
+#include <set>
+#include <utility>
+#include <vector>
 #include "automaton/compaction.h"
 #include "automaton/deterministic.h"
 #include "automaton/minimization.h"
 #include "automaton/closureProperties.h"
+#include "automaton/product.h"
+#include "utility/unionFind.h"
 
 /* Determina se os dois autômatos finitos são equivalentes, complementares
  * ou disjuntos (a interseção de suas linguages é vazia), ou se o primeiro
@@ -24,6 +29,29 @@ bool disjoint( DFA< State, Symbol >, DFA< State, Symbol > );
 template< typename State, typename Symbol >
 bool included( DFA< State, Symbol >, DFA< State, Symbol > );
 
+/* Versões que, quando a resposta é negativa, armazenam em word uma
+ * palavra de tamanho mínimo que a comprova: uma palavra aceita por
+ * exatamente um dos autômatos, aceita por ambos, ou aceita pelo
+ * primeiro e rejeitada pelo segundo, respectivamente.
+ *
+ * Apenas os pares de estados alcançáveis do produto dos autômatos
+ * são visitados, e a busca termina assim que a palavra é encontrada
+ * (veja automaton/product.h).
+ *
+ * equivalent usa o algoritmo de Hopcroft e Karp: os pares visitados
+ * são unidos numa estrutura union-find, e pares cujos estados já estão
+ * na mesma classe não são visitados novamente; assim, no máximo
+ * n1 + n2 pares são visitados, e o custo é O((n1 + n2) |Σ| α(n1 + n2)). */
+template< typename State, typename Symbol >
+bool equivalent( const DFA< State, Symbol >&, const DFA< State, Symbol >&,
+                 std::vector< Symbol >& word );
+template< typename State, typename Symbol >
+bool disjoint( const DFA< State, Symbol >&, const DFA< State, Symbol >&,
+               std::vector< Symbol >& word );
+template< typename State, typename Symbol >
+bool included( const DFA< State, Symbol >&, const DFA< State, Symbol >&,
+               std::vector< Symbol >& word );
+
 /* Determina se a linguagem do autômato é vazia, finita ou infinita. */
 template< typename State, typename Symbol >
 bool empty( DFA< State, Symbol > );
@@ -32,10 +60,16 @@ bool finite( DFA< State, Symbol > );
 template< typename State, typename Symbol >
 bool infinite( DFA< State, Symbol > );
 
+/* Versão de empty que, caso a linguagem não seja vazia, armazena em
+ * word uma palavra de tamanho mínimo aceita pelo autômato. */
+template< typename State, typename Symbol >
+bool empty( const DFA< State, Symbol >&, std::vector< Symbol >& word );
+
 // Implementação
 template< typename State, typename Symbol >
 bool equivalent( DFA< State, Symbol > dfa1, DFA< State, Symbol > dfa2 ) {
-    return included( dfa1, dfa2 ) && included( dfa2, dfa1 );
+    std::vector< Symbol > word;
+    return equivalent( dfa1, dfa2, word );
 }
 
 template< typename State, typename Symbol >
@@ -45,17 +79,112 @@ bool complementary( DFA< State, Symbol > dfa1, DFA< State, Symbol > dfa2 ) {
 
 template< typename State, typename Symbol >
 bool disjoint( DFA< State, Symbol > dfa1, DFA< State, Symbol > dfa2 ) {
-    return empty( automataIntersection( dfa1, dfa2 ) );
+    std::vector< Symbol > word;
+    return disjoint( dfa1, dfa2, word );
 }
 
 template< typename State, typename Symbol >
 bool included( DFA< State, Symbol > dfa1, DFA< State, Symbol > dfa2 ) {
-    return empty( automataSubtraction( dfa1, dfa2 ) );
+    std::vector< Symbol > word;
+    return included( dfa1, dfa2, word );
+}
+
+template< typename State, typename Symbol >
+bool equivalent( const DFA< State, Symbol >& dfa1,
+                 const DFA< State, Symbol >& dfa2, std::vector< Symbol >& word )
+{
+    std::set< Symbol > alphabet = dfa1.alphabet;
+    alphabet.insert( dfa2.alphabet.begin(), dfa2.alphabet.end() );
+    std::vector< Symbol > symbols( alphabet.begin(), alphabet.end() );
+    std::size_t k = symbols.size();
+    TransitionTable< Symbol > t1( dfa1, symbols ), t2( dfa2, symbols );
+
+    /* Os estados de dfa2 (incluindo o de rejeição) são deslocados de
+     * t1.n + 1 na estrutura union-find. Os pares são visitados em
+     * largura; pairs é a fila, e parent e via permitem reconstruir a
+     * palavra que leva a cada par.
+     *
+     * Se (p, q) é ignorado por p e q já estarem na mesma classe, uma
+     * palavra que distinga p de q distingue algum par já visitado desta
+     * classe, que não é mais profundo que (p, q); portanto, a primeira
+     * divergência encontrada corresponde a uma menor palavra. */
+    int offset = t1.n + 1;
+    UnionFind classes( offset + t2.n + 1 );
+    std::vector< std::pair< int, int > > pairs;
+    std::vector< int > parent, via;
+
+    word.clear();
+    auto visit = [&]( int p, int q, int from, int a ) {
+        if( classes.unite( p, offset + q ) ) {
+            pairs.push_back({ p, q });
+            parent.push_back( from );
+            via.push_back( a );
+        }
+    };
+
+    visit( t1.initialState, t2.initialState, -1, -1 );
+    for( std::size_t i = 0; i < pairs.size(); ++i ) {
+        int p = pairs[i].first, q = pairs[i].second;
+        if( t1.isFinal[p] != t2.isFinal[q] ) {
+            reconstructWord( i, parent, via, symbols, word );
+            return false;
+        }
+        for( std::size_t a = 0; a < k; ++a )
+            visit( t1.next[p * k + a], t2.next[q * k + a], i, a );
+    }
+    return true;
+}
+
+template< typename State, typename Symbol >
+bool disjoint( const DFA< State, Symbol >& dfa1,
+               const DFA< State, Symbol >& dfa2, std::vector< Symbol >& word )
+{
+    return !findInProduct( dfa1, dfa2,
+                           []( bool x, bool y ) { return x && y; }, word );
+}
+
+template< typename State, typename Symbol >
+bool included( const DFA< State, Symbol >& dfa1,
+               const DFA< State, Symbol >& dfa2, std::vector< Symbol >& word )
+{
+    return !findInProduct( dfa1, dfa2,
+                           []( bool x, bool y ) { return x && !y; }, word );
 }
 
 template< typename State, typename Symbol >
 bool empty( DFA< State, Symbol > dfa ) {
-    return minimize( compact(dfa) ).finalStates.empty();
+    std::vector< Symbol > word;
+    return empty( dfa, word );
+}
+
+template< typename State, typename Symbol >
+bool empty( const DFA< State, Symbol >& dfa, std::vector< Symbol >& word ) {
+    /* Busca em largura a partir do estado inicial, que termina no
+     * primeiro estado final encontrado. */
+    std::vector< Symbol > symbols( dfa.alphabet.begin(), dfa.alphabet.end() );
+    std::size_t k = symbols.size();
+    TransitionTable< Symbol > table( dfa, symbols );
+    std::vector< int > queue = { table.initialState };
+    std::vector< int > parent( table.n + 1, -2 ), via( table.n + 1 );
+    parent[table.initialState] = -1;
+
+    word.clear();
+    for( std::size_t i = 0; i < queue.size(); ++i ) {
+        int q = queue[i];
+        if( table.isFinal[q] ) {
+            reconstructWord( q, parent, via, symbols, word );
+            return false;
+        }
+        for( std::size_t a = 0; a < k; ++a ) {
+            int r = table.next[q * k + a];
+            if( parent[r] == -2 ) {
+                parent[r] = q;
+                via[r] = a;
+                queue.push_back( r );
+            }
+        }
+    }
+    return true;
 }
 
 template< typename State, typename Symbol >
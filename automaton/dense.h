@@ -0,0 +1,135 @@
+/* dense.h
+ * Autômato finito determinístico compilado numa tabela de transições
+ * densa, para execução rápida.
+ *
+ * A estrutura DFA mantém a correspondência com a definição matemática;
+ * cada transição custa duas buscas num std::map. DenseDFA é uma versão
+ * imutável de um DFA compacto, em que cada estado ocupa uma linha
+ * contígua da tabela, indexada pelo símbolo lido. Executar o autômato
+ * custa, então, um único acesso à tabela por símbolo.
+ *
+ * Apenas símbolos de um byte (char, signed char, unsigned char) são
+ * suportados, pois as linhas possuem uma entrada para cada byte.
+ */
+#ifndef DENSE_H
+#define DENSE_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "automaton/deterministic.h"
+
+template< typename Symbol >
+class DenseDFA {
+    static_assert( sizeof(Symbol) == 1,
+        "DenseDFA supports only byte-sized symbols" );
+
+public:
+    typedef std::uint32_t State;
+
+    /* Os estados são representados pelo deslocamento da sua linha na
+     * tabela: o estado q do autômato original corresponde à linha q + 1,
+     * e é representado por (q + 1) * rowSize. Assim, cada transição
+     * é um único acesso à tabela, sem multiplicações.
+     *
+     * O estado morto é reservado e ocupa a linha 0.
+     * Todas as transições indefinidas no autômato original levam
+     * a este estado, que não é final e transita apenas para si mesmo. */
+    static constexpr State dead = 0;
+
+    /* Quantidade de entradas em cada linha da tabela. */
+    static constexpr unsigned rowSize = 256;
+
+    /* Compila o autômato passado.
+     * O autômato deve ser compacto (veja automaton/compaction.h);
+     * caso contrário, std::domain_error é lançado. */
+    explicit DenseDFA( const DFA< int, Symbol >& );
+
+    /* Determina se o autômato aceita ou não a palavra delimitada
+     * pelo intervalo [begin, end). */
+    template< typename ForwardIterator >
+    bool accepts( ForwardIterator begin, ForwardIterator end ) const;
+
+    /* Estado inicial, transição e teste de estado final.
+     * Estes métodos permitem que algoritmos externos executem o
+     * autômato passo a passo. */
+    State initialState() const;
+    State next( State q, Symbol a ) const;
+    bool isFinal( State q ) const;
+
+    /* Quantidade de estados, incluindo o estado morto. */
+    std::size_t size() const;
+
+private:
+    std::vector< State > table; // table[q + a]
+    std::vector< std::uint64_t > finalStates; // Mapa de bits
+    State initial;
+};
+
+// Implementação
+
+template< typename Symbol >
+constexpr typename DenseDFA< Symbol >::State DenseDFA< Symbol >::dead;
+template< typename Symbol >
+constexpr unsigned DenseDFA< Symbol >::rowSize;
+
+template< typename Symbol >
+DenseDFA< Symbol >::DenseDFA( const DFA< int, Symbol >& dfa ) {
+    std::size_t n = dfa.states.size();
+    if( n > 0 && ( *dfa.states.begin() != 0 ||
+                   *dfa.states.rbegin() != int(n - 1) ) )
+        throw std::domain_error( "Automaton is not compact." );
+
+    /* A linha 0 (estado morto) é totalmente zerada; as demais começam
+     * também no estado morto e são preenchidas com as transições
+     * definidas no autômato original. */
+    table.assign( (n + 1) * rowSize, dead );
+    finalStates.assign( (n + 1 + 63) / 64, 0 );
+
+    for( const auto& pair : dfa.delta ) {
+        State q = (pair.first.first + 1) * rowSize;
+        unsigned char a = pair.first.second;
+        table[q + a] = (pair.second + 1) * rowSize;
+    }
+    for( int q : dfa.finalStates )
+        finalStates[(q + 1) / 64] |= std::uint64_t(1) << ((q + 1) % 64);
+
+    initial = n > 0 ? (dfa.initialState + 1) * rowSize : dead;
+}
+
+template< typename Symbol >
+template< typename ForwardIterator >
+bool DenseDFA< Symbol >::accepts( ForwardIterator begin,
+                                  ForwardIterator end ) const
+{
+    /* Como o estado morto é absorvente, não é necessário testá-lo
+     * dentro do laço; o custo por símbolo é apenas o acesso à tabela. */
+    const State * t = table.data();
+    State q = initial;
+    for( ; begin != end; ++begin )
+        q = t[q + (unsigned char) *begin];
+    return isFinal( q );
+}
+
+template< typename Symbol >
+auto DenseDFA< Symbol >::initialState() const -> State {
+    return initial;
+}
+
+template< typename Symbol >
+auto DenseDFA< Symbol >::next( State q, Symbol a ) const -> State {
+    return table[q + (unsigned char) a];
+}
+
+template< typename Symbol >
+bool DenseDFA< Symbol >::isFinal( State q ) const {
+    q /= rowSize;
+    return (finalStates[q / 64] >> (q % 64)) & 1;
+}
+
+template< typename Symbol >
+std::size_t DenseDFA< Symbol >::size() const {
+    return table.size() / rowSize;
+}
+
+#endif // DENSE_H
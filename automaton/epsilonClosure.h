@@ -0,0 +1,191 @@
+/* epsilonClosure.h
+ * Tabela com os fechos-épsilon de todos os estados de um NFAe.
+ *
+ * NFAe::epsilonClosure calcula o fecho de um único estado; algoritmos
+ * que precisam do fecho de todos os estados (como toNFA) refariam
+ * o mesmo trabalho diversas vezes. EpsilonClosureTable calcula todos
+ * os fechos de uma única vez:
+ *  - O grafo das transições-épsilon é condensado em componentes
+ *    fortemente conexas (algoritmo de Tarjan). Todos os estados de uma
+ *    mesma componente possuem o mesmo fecho, que é armazenado uma única
+ *    vez na tabela.
+ *  - O algoritmo de Tarjan encontra as componentes em ordem topológica
+ *    reversa; portanto, quando uma componente é encontrada, os fechos
+ *    de todas as componentes alcançáveis a partir dela já são conhecidos,
+ *    e o fecho da componente é a união destes fechos com os seus estados.
+ *
+ * A tabela pode ser construída uma vez e reutilizada por várias
+ * conversões do mesmo autômato; veja toNFA em conversion.h.
+ */
+#ifndef EPSILON_CLOSURE_H
+#define EPSILON_CLOSURE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+#include "automaton/nonDeterministicWithEpsilon.h"
+
+template< typename State >
+class EpsilonClosureTable {
+    std::vector< State > states; // Em ordem crescente
+    std::map< State, int > componentIndex; // Componente de cada estado
+    std::vector< std::vector< State > > closures; // Fecho de cada componente
+
+public:
+    /* Calcula os fechos-épsilon de todos os estados do autômato. */
+    template< typename Symbol >
+    explicit EpsilonClosureTable( const NFAe< State, Symbol >& );
+
+    /* Retorna o fecho-épsilon do estado passado, em ordem crescente.
+     * Caso o estado não pertença ao autômato, std::out_of_range
+     * é lançado. */
+    const std::vector< State >& operator()( const State& ) const;
+
+    /* Retorna a união dos fechos-épsilon dos estados passados. */
+    std::set< State > operator()( const std::set< State >& ) const;
+
+    /* Número da componente fortemente conexa do grafo de
+     * transições-épsilon à qual o estado pertence. Estados da mesma
+     * componente possuem o mesmo fecho-épsilon.
+     *
+     * As componentes são numeradas de 0 a components()-1, em ordem
+     * topológica reversa: se a componente c alcança d, então d <= c. */
+    int component( const State& ) const;
+    std::size_t components() const;
+};
+
+// Implementação
+
+template< typename State >
+template< typename Symbol >
+EpsilonClosureTable< State >::EpsilonClosureTable(
+        const NFAe< State, Symbol >& nfae ) :
+    states( nfae.states.begin(), nfae.states.end() )
+{
+    int n = states.size();
+    std::map< State, int > index;
+    for( int i = 0; i < n; ++i )
+        index.insert( index.end(), {states[i], i} );
+
+    std::vector< std::vector< int > > graph( n );
+    for( const auto& pair : nfae.delta.epsilonTransitions() ) {
+        std::vector< int >& edges = graph[index.at( pair.first )];
+        for( const State& r : pair.second )
+            edges.push_back( index.at( r ) );
+    }
+
+    /* Algoritmo de Tarjan, iterativo, para que autômatos grandes não
+     * esgotem a pilha de execução.
+     *
+     * order[i] é a ordem em que i foi visitado (-1 se não visitado);
+     * low[i] é a menor ordem alcançável a partir de i dentro da pilha;
+     * componentOf[i] é a componente de i, ou -1 se ainda não definida. */
+    std::vector< int > order( n, -1 ), low( n ), componentOf( n, -1 );
+    std::vector< int > stack; // Pilha de Tarjan
+    std::vector< std::pair< int, std::size_t > > calls; // (vértice, aresta)
+    std::vector< int > stamp( n, -1 ); // Evita repetições nas uniões
+    std::vector< std::vector< int > > indices; // Fechos, por índice
+    int counter = 0;
+
+    for( int root = 0; root < n; ++root ) {
+        if( order[root] != -1 )
+            continue;
+        calls.push_back({ root, 0 });
+        order[root] = low[root] = counter++;
+        stack.push_back( root );
+
+        while( !calls.empty() ) {
+            int v = calls.back().first;
+            std::size_t& edge = calls.back().second;
+            if( edge < graph[v].size() ) {
+                int w = graph[v][edge++];
+                if( order[w] == -1 ) {
+                    order[w] = low[w] = counter++;
+                    stack.push_back( w );
+                    calls.push_back({ w, 0 });
+                } else if( componentOf[w] == -1 )
+                    low[v] = std::min( low[v], order[w] );
+                continue;
+            }
+
+            calls.pop_back();
+            if( !calls.empty() ) {
+                int u = calls.back().first;
+                low[u] = std::min( low[u], low[v] );
+            }
+            if( low[v] != order[v] )
+                continue;
+
+            /* v é a raiz de uma componente; seus membros estão no topo
+             * da pilha. As componentes alcançáveis já foram fechadas. */
+            int c = indices.size();
+            std::vector< int > members;
+            int w;
+            do {
+                w = stack.back();
+                stack.pop_back();
+                componentOf[w] = c;
+                members.push_back( w );
+            } while( w != v );
+
+            std::vector< int > closure;
+            for( int m : members ) {
+                stamp[m] = c;
+                closure.push_back( m );
+            }
+            for( int m : members )
+                for( int s : graph[m] )
+                    if( componentOf[s] != c )
+                        for( int i : indices[componentOf[s]] )
+                            if( stamp[i] != c ) {
+                                stamp[i] = c;
+                                closure.push_back( i );
+                            }
+            std::sort( closure.begin(), closure.end() );
+            indices.push_back( std::move( closure ) );
+        }
+    }
+
+    closures.resize( indices.size() );
+    for( std::size_t c = 0; c < indices.size(); ++c )
+        for( int i : indices[c] )
+            closures[c].push_back( states[i] );
+
+    for( int i = 0; i < n; ++i )
+        componentIndex.insert( componentIndex.end(),
+                               {states[i], componentOf[i]} );
+}
+
+template< typename State >
+const std::vector< State >& EpsilonClosureTable< State >::operator()(
+        const State& q ) const
+{
+    return closures[componentIndex.at( q )];
+}
+
+template< typename State >
+std::set< State > EpsilonClosureTable< State >::operator()(
+        const std::set< State >& s ) const
+{
+    std::set< State > r;
+    for( const State& q : s ) {
+        const std::vector< State >& c = operator()( q );
+        r.insert( c.begin(), c.end() );
+    }
+    return r;
+}
+
+template< typename State >
+int EpsilonClosureTable< State >::component( const State& q ) const {
+    return componentIndex.at( q );
+}
+
+template< typename State >
+std::size_t EpsilonClosureTable< State >::components() const {
+    return closures.size();
+}
+
+#endif // EPSILON_CLOSURE_H
@@ -0,0 +1,454 @@
+/* lazyDeterministic.h
+ * Autômato finito determinístico construído sob demanda a partir
+ * de um autômato finito não-determinístico com transições-épsilon.
+ *
+ * A determinização completa de alguns autômatos produz uma quantidade
+ * exponencial de estados, embora a execução sobre entradas reais visite
+ * apenas uma pequena parte deles. LazyDFA constrói cada estado (um
+ * subconjunto fechado por épsilon dos estados do NFAe) apenas quando
+ * a entrada o alcança pela primeira vez, e guarda os estados e as
+ * transições já calculadas numa cache de tamanho limitado.
+ *
+ * Quando a cache enche, ela é esvaziada por completo (apenas o estado
+ * atual é mantido). Caso a cache seja esvaziada com muita frequência,
+ * isto é, se poucos símbolos forem lidos entre dois esvaziamentos, a
+ * execução atual abandona a cache e simula o NFAe diretamente, conjunto
+ * a conjunto. Esta estratégia é a mesma do DFA do RE2.
+ *
+ * No modo não-ancorado, o autômato reconhece Σ*L, em que L é a linguagem
+ * do NFAe: após cada símbolo, o fecho do estado inicial é unido ao
+ * conjunto atual, como se uma nova execução começasse em cada posição.
+ * O laço Σ* nunca é construído explicitamente; ele é determinizado sob
+ * demanda, junto com os demais estados.
+ *
+ * Apenas símbolos de um byte são suportados.
+ */
+#ifndef LAZY_DETERMINISTIC_H
+#define LAZY_DETERMINISTIC_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include "automaton/nonDeterministicWithEpsilon.h"
+#include "utility/bitset.h"
+
+template< typename Symbol >
+class LazyDFA {
+    static_assert( sizeof(Symbol) == 1,
+        "LazyDFA supports only byte-sized symbols" );
+
+public:
+    /* Contadores de uso da cache.
+     *  hits      - transições encontradas na cache;
+     *  misses    - transições que precisaram ser calculadas;
+     *  flushes   - quantidade de vezes que a cache foi esvaziada;
+     *  fallbacks - execuções que abandonaram a cache e simularam
+     *              o NFAe diretamente. */
+    struct Statistics {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        std::size_t flushes = 0;
+        std::size_t fallbacks = 0;
+    };
+
+    /* Modo de execução; veja o comentário no início do arquivo. */
+    enum class Mode { Anchored, Unanchored };
+
+    /* Constrói o autômato, inicialmente apenas com o estado inicial.
+     *
+     * memoryBudget é a quantidade aproximada de bytes que a cache de
+     * estados pode ocupar.
+     *
+     * Os estados do autômato devem ser {0, 1, ..., n-1}, como no autômato
+     * retornado por thompson(); caso contrário, std::domain_error
+     * é lançado. */
+    explicit LazyDFA( const NFAe< int, Symbol >&,
+                      std::size_t memoryBudget = 1 << 20,
+                      Mode mode = Mode::Anchored );
+
+    /* Determina se o autômato aceita ou não a palavra delimitada
+     * pelo intervalo [begin, end).
+     *
+     * Este método não é constante, pois altera a cache. */
+    template< typename ForwardIterator >
+    bool accepts( ForwardIterator begin, ForwardIterator end );
+
+    /* Executa o autômato sobre o intervalo [begin, end) e chama
+     * report( i ) para cada i, em ordem crescente, tal que o prefixo
+     * de tamanho i do intervalo é aceito (0 <= i <= tamanho).
+     *
+     * No modo ancorado, a leitura termina assim que nenhuma continuação
+     * puder ser aceita. */
+    template< typename ForwardIterator, typename F >
+    void scan( ForwardIterator begin, ForwardIterator end, F report );
+
+    /* Como scan, mas, em cada posição i (antes de report( i )), chama
+     * visit( i, q ), em que q é o número do estado atual na cache; caso
+     * visit retorne false, a leitura termina. Os números só identificam
+     * os estados até o próximo esvaziamento da cache (veja
+     * statistics().flushes); após abandonar a cache, visit não é mais
+     * chamado. */
+    template< typename ForwardIterator, typename F, typename G >
+    void scan( ForwardIterator begin, ForwardIterator end, F report,
+               G visit );
+
+    /* Contadores de uso da cache, desde a construção. */
+    const Statistics& statistics() const;
+
+    /* Quantidade de estados atualmente na cache. */
+    std::size_t cachedStates() const;
+
+private:
+    static constexpr int unknown = -1;
+
+    /* Quantidade de símbolos lidos por estado na cache, entre dois
+     * esvaziamentos, abaixo da qual consideramos que a cache não
+     * está sendo útil. */
+    static constexpr std::size_t minimumProgress = 10;
+
+    struct CachedState {
+        const Bitset * subset; // Chave em ids
+        bool final;
+        bool dead; // Nenhum estado do subconjunto alcança estados finais
+        std::vector< int > next; // next[a], ou unknown
+    };
+
+    /* NFAe, em forma de listas de adjacência.
+     * No modo não-ancorado, os bytes fora do alfabeto são lidos como um
+     * símbolo extra, de índice k-1, sem transições; assim, eles levam
+     * de volta ao estado inicial. */
+    std::size_t n, k;
+    bool unanchored;
+    std::vector< std::vector< int > > epsilonSuccessors; // [q]
+    std::vector< std::vector< int > > successors; // [q*k + a]
+    int symbolIndex[256]; // Índice do byte no alfabeto, ou -1
+    Bitset finalStates;
+    Bitset liveStates; // Estados que alcançam algum estado final
+    Bitset start; // Fecho-épsilon do estado inicial
+
+    // Cache
+    std::vector< CachedState > cache;
+    std::unordered_map< Bitset, int, BitsetHash > ids;
+    std::size_t memoryBudget;
+    std::size_t stateCost; // Custo aproximado, em bytes, de cada estado
+    std::size_t symbolsSinceFlush = 0;
+    Statistics stats;
+
+    /* Substitui s pelo seu fecho-épsilon. */
+    void close( Bitset& s ) const;
+
+    /* Calcula o fecho-épsilon dos estados alcançados a partir de s por a;
+     * no modo não-ancorado, o resultado inclui também start. */
+    void move( const Bitset& s, int a, Bitset& out ) const;
+
+    /* Retorna o número do estado na cache, inserindo-o se necessário.
+     * Quem insere deve garantir que há espaço na cache. */
+    int intern( const Bitset& );
+
+    /* Calcula a transição do estado q pelo símbolo a, inserindo o
+     * destino na cache. Retorna unknown caso a cache esteja sendo
+     * esvaziada com muita frequência; neste caso, out contém o destino. */
+    int transition( int q, int a, Bitset& out );
+
+    /* Esvazia a cache. */
+    void flush();
+
+    /* Simula o NFAe a partir do conjunto s, sem usar a cache.
+     * simulateScan é a versão correspondente de scan; position é a
+     * quantidade de símbolos já lidos antes de begin. */
+    template< typename ForwardIterator >
+    bool simulate( Bitset s, ForwardIterator begin, ForwardIterator end );
+    template< typename ForwardIterator, typename F >
+    void simulateScan( Bitset s, ForwardIterator begin, ForwardIterator end,
+                       std::size_t position, F report );
+};
+
+// Implementação
+
+template< typename Symbol >
+constexpr int LazyDFA< Symbol >::unknown;
+template< typename Symbol >
+constexpr std::size_t LazyDFA< Symbol >::minimumProgress;
+
+template< typename Symbol >
+LazyDFA< Symbol >::LazyDFA( const NFAe< int, Symbol >& nfae,
+        std::size_t memoryBudget, Mode mode ) :
+    n( nfae.states.size() ),
+    k( nfae.alphabet.size() + (mode == Mode::Unanchored) ),
+    unanchored( mode == Mode::Unanchored ),
+    epsilonSuccessors( n ),
+    successors( n * k ),
+    finalStates( n ),
+    liveStates( n ),
+    start( n ),
+    memoryBudget( memoryBudget )
+{
+    if( n > 0 && ( *nfae.states.begin() != 0 ||
+                   *nfae.states.rbegin() != int(n - 1) ) )
+        throw std::domain_error( "Automaton is not compact." );
+
+    for( int& i : symbolIndex )
+        i = unanchored ? int(k - 1) : -1;
+    int a = 0;
+    for( Symbol c : nfae.alphabet )
+        symbolIndex[(unsigned char) c] = a++;
+
+    for( const auto& pair : nfae.delta.symbolTransitions() ) {
+        int q = pair.first.first;
+        Symbol c = pair.first.second;
+        if( symbolIndex[(unsigned char) c] >= 0 )
+            successors[q * k + symbolIndex[(unsigned char) c]]
+                .assign( pair.second.begin(), pair.second.end() );
+    }
+    for( const auto& pair : nfae.delta.epsilonTransitions() )
+        epsilonSuccessors[pair.first] = pair.second;
+
+    for( int q : nfae.finalStates )
+        finalStates.set( q );
+
+    /* Estados vivos: busca a partir dos estados finais, no grafo com
+     * as transições invertidas. */
+    std::vector< std::vector< int > > predecessors( n );
+    for( std::size_t q = 0; q < n; ++q ) {
+        for( int r : epsilonSuccessors[q] )
+            predecessors[r].push_back( q );
+        for( std::size_t b = 0; b < k; ++b )
+            for( int r : successors[q * k + b] )
+                predecessors[r].push_back( q );
+    }
+    std::vector< int > stack( nfae.finalStates.begin(),
+                              nfae.finalStates.end() );
+    liveStates = finalStates;
+    while( !stack.empty() ) {
+        int q = stack.back();
+        stack.pop_back();
+        for( int p : predecessors[q] )
+            if( !liveStates.test( p ) ) {
+                liveStates.set( p );
+                stack.push_back( p );
+            }
+    }
+
+    if( n > 0 ) {
+        start.set( nfae.initialState );
+        close( start );
+    }
+
+    /* Cada estado ocupa o subconjunto (na chave de ids), a entrada em
+     * cache, o vetor de transições e, aproximadamente, três ponteiros
+     * do nó da tabela hash. */
+    stateCost = sizeof(Bitset) + (n + 63) / 64 * 8 + sizeof(CachedState) +
+                k * sizeof(int) + 3 * sizeof(void*) + sizeof(int);
+}
+
+template< typename Symbol >
+template< typename ForwardIterator >
+bool LazyDFA< Symbol >::accepts( ForwardIterator begin, ForwardIterator end )
+{
+    int q = intern( start );
+
+    /* Os acertos são contados numa variável local, e repassados para
+     * stats e symbolsSinceFlush apenas nas falhas; assim, o laço
+     * principal não escreve na memória. */
+    std::size_t hits = 0;
+    auto account = [&]() {
+        stats.hits += hits;
+        symbolsSinceFlush += hits;
+        hits = 0;
+    };
+
+    Bitset target( n );
+    for( ; begin != end; ++begin ) {
+        if( cache[q].dead )
+            break;
+        int a = symbolIndex[(unsigned char) *begin];
+        if( a < 0 ) {
+            account();
+            return false;
+        }
+
+        int r = cache[q].next[a];
+        if( r != unknown ) {
+            ++hits;
+            q = r;
+            continue;
+        }
+        account();
+        stats.misses++;
+        symbolsSinceFlush++;
+        q = transition( q, a, target );
+        if( q == unknown ) {
+            stats.fallbacks++;
+            return simulate( target, ++begin, end );
+        }
+    }
+    account();
+    return cache[q].final;
+}
+
+template< typename Symbol >
+template< typename ForwardIterator, typename F >
+void LazyDFA< Symbol >::scan( ForwardIterator begin, ForwardIterator end,
+                              F report )
+{
+    scan( begin, end, report, []( std::size_t, int ) { return true; } );
+}
+
+template< typename Symbol >
+template< typename ForwardIterator, typename F, typename G >
+void LazyDFA< Symbol >::scan( ForwardIterator begin, ForwardIterator end,
+                              F report, G visit )
+{
+    int q = intern( start );
+    std::size_t position = 0;
+    Bitset target( n );
+    for( ;; ++begin ) {
+        if( !visit( position, q ) )
+            return;
+        if( cache[q].final )
+            report( position );
+        if( begin == end || cache[q].dead )
+            return;
+        int a = symbolIndex[(unsigned char) *begin];
+        if( a < 0 )
+            return;
+        ++position;
+
+        int r = cache[q].next[a];
+        if( r != unknown ) {
+            stats.hits++;
+            symbolsSinceFlush++;
+            q = r;
+            continue;
+        }
+        stats.misses++;
+        symbolsSinceFlush++;
+        q = transition( q, a, target );
+        if( q == unknown ) {
+            stats.fallbacks++;
+            simulateScan( target, ++begin, end, position, report );
+            return;
+        }
+    }
+}
+
+template< typename Symbol >
+auto LazyDFA< Symbol >::statistics() const -> const Statistics& {
+    return stats;
+}
+
+template< typename Symbol >
+std::size_t LazyDFA< Symbol >::cachedStates() const {
+    return cache.size();
+}
+
+template< typename Symbol >
+void LazyDFA< Symbol >::close( Bitset& s ) const {
+    std::vector< int > stack;
+    s.forEach( [&]( std::size_t q ) { stack.push_back( q ); } );
+    while( !stack.empty() ) {
+        int q = stack.back();
+        stack.pop_back();
+        for( int r : epsilonSuccessors[q] )
+            if( !s.test( r ) ) {
+                s.set( r );
+                stack.push_back( r );
+            }
+    }
+}
+
+template< typename Symbol >
+void LazyDFA< Symbol >::move( const Bitset& s, int a, Bitset& out ) const {
+    out.clear();
+    s.forEach( [&]( std::size_t q ) {
+        for( int r : successors[q * k + a] )
+            out.set( r );
+    });
+    close( out );
+    if( unanchored )
+        out |= start;
+}
+
+template< typename Symbol >
+int LazyDFA< Symbol >::intern( const Bitset& s ) {
+    auto pair = ids.insert({ s, (int) cache.size() });
+    if( pair.second ) {
+        const Bitset * key = &pair.first->first;
+        cache.push_back({ key, key->intersects( finalStates ),
+                          !key->intersects( liveStates ),
+                          std::vector< int >( k, unknown ) });
+    }
+    return pair.first->second;
+}
+
+template< typename Symbol >
+int LazyDFA< Symbol >::transition( int q, int a, Bitset& out ) {
+    move( *cache[q].subset, a, out );
+
+    auto it = ids.find( out );
+    if( it != ids.end() )
+        return cache[q].next[a] = it->second;
+
+    if( (cache.size() + 1) * stateCost > memoryBudget ) {
+        /* A cache está cheia. Se ela estiver sendo útil, a esvaziamos
+         * e continuamos a partir do estado atual; caso contrário,
+         * desistimos da cache nesta execução. */
+        bool thrashing = symbolsSinceFlush < minimumProgress * cache.size();
+        Bitset current = *cache[q].subset;
+        flush();
+        if( thrashing )
+            return unknown;
+        q = intern( current );
+    }
+
+    int r = intern( out );
+    cache[q].next[a] = r;
+    return r;
+}
+
+template< typename Symbol >
+void LazyDFA< Symbol >::flush() {
+    cache.clear();
+    ids.clear();
+    stats.flushes++;
+    symbolsSinceFlush = 0;
+}
+
+template< typename Symbol >
+template< typename ForwardIterator >
+bool LazyDFA< Symbol >::simulate( Bitset s, ForwardIterator begin,
+                                  ForwardIterator end )
+{
+    Bitset next( n );
+    for( ; begin != end; ++begin ) {
+        int a = symbolIndex[(unsigned char) *begin];
+        if( a < 0 || !s.intersects( liveStates ) )
+            return false;
+        move( s, a, next );
+        std::swap( s, next );
+    }
+    return s.intersects( finalStates );
+}
+
+template< typename Symbol >
+template< typename ForwardIterator, typename F >
+void LazyDFA< Symbol >::simulateScan( Bitset s, ForwardIterator begin,
+        ForwardIterator end, std::size_t position, F report )
+{
+    Bitset next( n );
+    for( ;; ++begin ) {
+        if( s.intersects( finalStates ) )
+            report( position );
+        if( begin == end || !s.intersects( liveStates ) )
+            return;
+        int a = symbolIndex[(unsigned char) *begin];
+        if( a < 0 )
+            return;
+        ++position;
+        move( s, a, next );
+        std::swap( s, next );
+    }
+}
+
+#endif // LAZY_DETERMINISTIC_H
@@ -4,10 +4,12 @@
 #ifndef MINIMIZATION_H
 #define MINIMIZATION_H
 
-#include <algorithm>
+#include <cstddef>
 #include <functional>
-#include <iterator>
 #include <map>
+#include <utility>
+#include <vector>
+#include "automaton/alphabetClasses.h"
 #include "automaton/deterministic.h"
 
 /* Constrói o autômato mínimo equivalente ao autômato passado.
@@ -32,11 +34,29 @@ DFA< State, Symbol > removeDead( DFA< State, Symbol > );
 /* Remove estados redundantes.
  * Dois estados são equivalentes se, trocar o estado inicial para
  * um deles resulta na mesma linguagem obtida ao trocar para o outro.
- * Esta função manterá apenas um destes estados no autômato retornado.
- */
+ * Esta função manterá apenas um destes estados no autômato retornado:
+ * o menor estado de cada classe de equivalência.
+ *
+ * O autômato deve estar completo (veja completeTransitions). */
 template< typename State, typename Symbol >
 DFA< State, Symbol > removeRedundant( DFA< State, Symbol > );
 
+/* Algoritmo de Hopcroft, que faz o trabalho pesado de removeRedundant.
+ *
+ * Os estados são os inteiros 0, 1, ..., n-1 e os símbolos são os
+ * inteiros 0, 1, ..., k-1; delta[q*k + a] é o destino da transição
+ * de q por a, e deve estar definido para todos os pares.
+ *
+ * initial[q] é o rótulo do estado q; estados de rótulos diferentes
+ * jamais serão considerados equivalentes. Em removeRedundant, o rótulo
+ * indica se o estado é final ou não, mas qualquer partição inicial
+ * pode ser usada.
+ *
+ * O retorno associa cada estado à sua classe de equivalência, numerada
+ * a partir de zero. A complexidade é O(n k log n). */
+inline std::vector< int > refinePartition( const std::vector< int >& delta,
+        std::size_t k, const std::vector< int >& initial );
+
 // Implementação
 template< typename State, typename Symbol >
 DFA< State, Symbol > minimize( DFA< State, Symbol > dfa ) {
@@ -147,118 +167,192 @@ DFA< State, Symbol > removeDead( DFA< State, Symbol > dfa ) {
 
 template< typename State, typename Symbol >
 DFA< State, Symbol > removeRedundant( DFA< State, Symbol > dfa ) {
-    using std::set;
-
-    set< set< State > > equivalenceClasses;
-    /* Se o conjunto de estados finais for vazio, o conjunto das
-     * classes de equivalência conterá apenas o conjunto dos estados.
-     * Caso contrário, começaremos com duas classes: finais e não-finais. */
-    if( dfa.finalStates.empty() )
-        equivalenceClasses.insert( dfa.states );
-    else {
-        set< State > alce;
-        std::set_difference( dfa.states.begin(), dfa.states.end(),
-                dfa.finalStates.begin(), dfa.finalStates.end(),
-                std::inserter( alce, alce.end() ) );
-        equivalenceClasses.insert( alce );
-        equivalenceClasses.insert( dfa.finalStates );
+    /* Numeraremos os estados e os símbolos conforme a ordem dos conjuntos,
+     * para que refinePartition trabalhe apenas com inteiros. */
+    std::vector< State > states( dfa.states.begin(), dfa.states.end() );
+    std::vector< Symbol > symbols( dfa.alphabet.begin(), dfa.alphabet.end() );
+    std::map< State, int > index;
+    for( std::size_t i = 0; i < states.size(); ++i )
+        index[states[i]] = i;
+
+    std::vector< int > delta( states.size() * symbols.size() );
+    std::vector< int > label( states.size() );
+    for( std::size_t q = 0; q < states.size(); ++q ) {
+        for( std::size_t a = 0; a < symbols.size(); ++a )
+            delta[q * symbols.size() + a] =
+                index.at( dfa.delta({ states[q], symbols[a] }) );
+        label[q] = dfa.finalStates.count( states[q] );
     }
+    /* Símbolos que nenhuma transição distingue (veja
+     * automaton/alphabetClasses.h) produzem os mesmos refinamentos;
+     * basta refinar a partição com um símbolo de cada classe. */
+    std::size_t k = symbols.size();
+    std::vector< int > symbolClass = partitionColumns( delta, k );
+    std::vector< std::size_t > classSymbol;
+    for( std::size_t a = 0; a < k; ++a )
+        if( symbolClass[a] == (int) classSymbol.size() )
+            classSymbol.push_back( a );
+    std::vector< int > reduced( states.size() * classSymbol.size() );
+    for( std::size_t q = 0; q < states.size(); ++q )
+        for( std::size_t c = 0; c < classSymbol.size(); ++c )
+            reduced[q * classSymbol.size() + c] = delta[q * k + classSymbol[c]];
+
+    /* Começamos com duas classes de equivalência: finais e não-finais. */
+    std::vector< int > block = refinePartition( reduced, classSymbol.size(),
+                                                label );
 
-    /* true se os dois estados estão na mesma classe de equivalência,
-     * false caso contrário. */
-    auto sameEquivalenceClass = [&]( State q, State r ) {
-        for( set< State > s : equivalenceClasses )
-            if( s.count(q) > 0 ) {
-                if( s.count(r) > 0 )
-                    return true;
-                else
-                    return false;
-            }
-        return false;
-    };
-
-    /* Dois estados são equivalentes se eles pertencerem
-     * às mesmas classes de equivalência e todas as transições
-     * partindo deles terminam em estados nas mesmas classes
-     * de equivalência. */
-    auto equivalent = [&]( State q, State r ) {
-        if( !sameEquivalenceClass( q, r ) )
-            return false;
-        for( Symbol a : dfa.alphabet )
-            if( !sameEquivalenceClass( dfa.delta({q, a}), dfa.delta({r, a}) ) )
-                return false;
-        return true;
-    };
+    // Remontar o autômato
 
-    /* Quebra a classe de equivalência s em duas: uma contendo os
-     * estados equivalentes a q, e outra contendo os demais estados.
-     * 
-     * A classe original é removida do conjunto de classes de equivalência
-     * e as duas novas classes são inseridas. */
-    auto split = [&]( set< State > s, State q ) {
-        set< State > c1, c2;
-        for( State r : s )
-            if( equivalent( r, q ) )
-                c1.insert( r );
-            else
-                c2.insert( r );
-        equivalenceClasses.erase( s );
-        equivalenceClasses.insert( c1 );
-        equivalenceClasses.insert( c2 );
+    /* O representante de cada classe é o seu menor estado; como os
+     * estados foram numerados em ordem crescente, é o de menor índice. */
+    std::vector< int > representative( states.size(), -1 );
+    for( std::size_t q = states.size(); q-- > 0; )
+        representative[block[q]] = q;
+    auto classRepresentative = [&]( int q ) {
+        return states[representative[block[q]]];
     };
 
-    bool changed = true;
-    while( changed ) { // Montar as classes de equivalência:
-        changed = false;
-        for( const set< State > s : equivalenceClasses ) {
-            if( s.size() == 1 )
-                continue;
-            else {
-                for( auto it = s.begin(); it != s.end(); ++it )
-                    for( auto jt = it; jt != s.end(); ++jt )
-                        if( !equivalent( *it, *jt ) ) {
-                            split( s, *it );
-                            changed = true;
-                            goto continue_external_loop; // ineficiente...
-                        }
-            }
-        }
-continue_external_loop:
-        ;
+    DFA< State, Symbol > r;
+    r.alphabet = dfa.alphabet;
+    r.initialState = dfa.initialState;
+    if( index.count( dfa.initialState ) > 0 )
+        r.initialState = classRepresentative( index[dfa.initialState] );
+
+    for( std::size_t q = 0; q < states.size(); ++q ) {
+        if( states[q] != classRepresentative( q ) )
+            continue;
+        r.states.insert( states[q] );
+        if( label[q] )
+            r.finalStates.insert( states[q] );
+        for( std::size_t a = 0; a < symbols.size(); ++a )
+            r.delta.insert( {states[q], symbols[a]},
+                    classRepresentative( delta[q * symbols.size() + a] ) );
     }
 
-    // Remontar o autômato
+    return r;
+}
 
-    /* Retorna o elemento que representará o conjunto passado. */
-    auto representative = [&]( set< State > s ) {
-        return *s.begin();
-    };
-    /* Retorna a classe de equivalência do estado passado. */
-    auto equivalenceClass = [&]( State q ) {
-        for( set< State > s : equivalenceClasses )
-            if( s.count( q ) > 0 )
-                return s;
-        return set< State >();
-    };
-    /* Retorna o representante da classe de equivalência do estado. */
-    auto classRepresentative = [&]( State q ) {
-        return representative( equivalenceClass( q ) );
+inline std::vector< int > refinePartition( const std::vector< int >& delta,
+        std::size_t k, const std::vector< int >& initial )
+{
+    std::size_t n = initial.size();
+
+    /* Transições inversas, armazenadas contiguamente: os predecessores
+     * de t pelo símbolo a estão em inverse[inverseBegin[t*k + a]] até
+     * inverse[inverseBegin[t*k + a + 1]]. */
+    std::vector< int > inverseBegin( n * k + 1, 0 );
+    std::vector< int > inverse( n * k );
+    for( std::size_t i = 0; i < n * k; ++i )
+        inverseBegin[delta[i] * k + i % k + 1]++;
+    for( std::size_t i = 0; i < n * k; ++i )
+        inverseBegin[i + 1] += inverseBegin[i];
+    {
+        std::vector< int > cursor( inverseBegin.begin(), inverseBegin.end() - 1 );
+        for( std::size_t i = 0; i < n * k; ++i )
+            inverse[cursor[delta[i] * k + i % k]++] = i / k;
+    }
+
+    /* A partição é representada pelo vetor elements, em que os estados
+     * de cada bloco B ocupam o intervalo [first[B], past[B]).
+     * location[q] é a posição de q em elements e block[q] é o bloco de q.
+     *
+     * Durante o processamento de um divisor, os estados marcados de
+     * cada bloco B são movidos para o início do seu intervalo;
+     * marked[B] é a quantidade de estados marcados. */
+    std::vector< int > elements( n ), location( n ), block( n );
+    std::vector< int > first, past, marked;
+
+    std::map< int, std::vector< int > > initialBlocks;
+    for( std::size_t q = 0; q < n; ++q )
+        initialBlocks[initial[q]].push_back( q );
+    int position = 0;
+    for( const auto& pair : initialBlocks ) {
+        first.push_back( position );
+        for( int q : pair.second ) {
+            elements[position] = q;
+            location[q] = position++;
+            block[q] = first.size() - 1;
+        }
+        past.push_back( position );
+        marked.push_back( 0 );
+    }
+    auto size = [&]( int B ) { return past[B] - first[B]; };
+
+    /* Lista de divisores (bloco, símbolo) pendentes.
+     * pending[B*k + a] indica se (B, a) está na lista. */
+    std::vector< std::pair< int, int > > worklist;
+    std::vector< char > pending( first.size() * k, false );
+    auto schedule = [&]( int B, int a ) {
+        if( pending[B * k + a] ) return;
+        pending[B * k + a] = true;
+        worklist.push_back({ B, a });
     };
-    
-    DFA< State, Symbol > r;
-    r.alphabet = dfa.alphabet;
-    r.initialState = classRepresentative( dfa.initialState );
 
-    for( State q : dfa.states )
-        r.states.insert( classRepresentative( q ) );
+    /* Basta refinar a partição com relação a todos os blocos exceto um;
+     * descartaremos o maior deles. */
+    int largest = 0;
+    for( std::size_t B = 0; B < first.size(); ++B )
+        if( size( B ) > size( largest ) )
+            largest = B;
+    for( std::size_t B = 0; B < first.size(); ++B )
+        if( int(B) != largest )
+            for( std::size_t a = 0; a < k; ++a )
+                schedule( B, a );
+
+    std::vector< int > splitter, touched;
+    while( !worklist.empty() ) {
+        int S = worklist.back().first;
+        int a = worklist.back().second;
+        worklist.pop_back();
+        pending[S * k + a] = false;
+
+        /* Marcar move estados dentro dos blocos, inclusive dentro de S;
+         * portanto, copiamos S antes de percorrê-lo. */
+        splitter.assign( elements.begin() + first[S],
+                         elements.begin() + past[S] );
+        for( int t : splitter )
+            for( int i = inverseBegin[t*k + a]; i < inverseBegin[t*k + a + 1]; ++i ) {
+                int p = inverse[i];
+                int B = block[p];
+                int target = first[B] + marked[B];
+                if( location[p] < target )
+                    continue; // p já foi marcado
+                if( marked[B] == 0 )
+                    touched.push_back( B );
+                int q = elements[target];
+                elements[target] = p;
+                elements[location[p]] = q;
+                location[q] = location[p];
+                location[p] = target;
+                marked[B]++;
+            }
 
-    for( State q : dfa.finalStates )
-        r.finalStates.insert( classRepresentative( q ) );
+        /* Cada bloco tocado é dividido em marcados e não-marcados.
+         * Os marcados formam um novo bloco C. */
+        for( int B : touched ) {
+            int m = marked[B];
+            marked[B] = 0;
+            if( m == size( B ) )
+                continue;
 
-    for( State q : r.states )
-        for( Symbol a : r.alphabet )
-            r.delta.insert( {q, a}, classRepresentative( dfa.delta({q, a}) ) );
+            int C = first.size();
+            first.push_back( first[B] );
+            past.push_back( first[B] + m );
+            marked.push_back( 0 );
+            first[B] += m;
+            for( int i = first[C]; i < past[C]; ++i )
+                block[elements[i]] = C;
+
+            pending.resize( first.size() * k, false );
+            for( std::size_t b = 0; b < k; ++b )
+                if( pending[B * k + b] )
+                    schedule( C, b );
+                else
+                    schedule( size( C ) < size( B ) ? C : B, b );
+        }
+        touched.clear();
+    }
 
-    return r;
+    return block;
 }
 #endif // MINIMIZATION_H
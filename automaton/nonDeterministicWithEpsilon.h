@@ -1,23 +1,25 @@
 /* nonDeterministicWithEpsilon.h
  * Estrutura que representa um autômato finito não determinístico
  * com transições epsilon.
+ *
+ * A função de transição é um TransitionsWithEpsilon
+ * (automaton/transitionsWithEpsilon.h), que guarda as
+ * transições-épsilon separadas das transições por símbolo.
  */
 #ifndef NON_DETERMINISTIC_WITH_EPSILON_H
 #define NON_DETERMINISTIC_WITH_EPSILON_H
 
 #include <set>
-#include <utility>
+#include <vector>
 #include "epsilon.h"
-#include "math/function.h"
+#include "automaton/transitionsWithEpsilon.h"
 #include "utility/either.h"
 
 template< typename State, typename Symbol >
 struct NFAe {
     std::set< State > states;
     std::set< Symbol > alphabet;
-    Math::Function< std::pair<State, Either<Symbol, Epsilon> >, 
-                    std::set<State>
-                  > delta;
+    TransitionsWithEpsilon< State, Symbol > delta;
 
     State initialState;
     std::set< State > finalStates;
@@ -41,38 +43,28 @@ struct NFAe {
 
 template< typename State, typename Symbol >
 std::set< State > NFAe<State, Symbol>::epsilonClosure( State q ) const {
-    /* Retorna o conjunto de estados atingido por uma única transição-épsilon
-     * a partir do estado passado. */
-    auto epsilonMove = [&]( State q ) -> std::set< State > {
-        if( delta.onDomain({q, epsilon}) )
-            return delta({q, epsilon});
-        return std::set< State >();
-    };
-
-    /* Une o segundo conjunto ao primeiro. */
-    auto setUnion = []( std::set<State>& base, const std::set<State>& target ) {
-        base.insert( target.begin(), target.end() );
-    };
-
-    std::set< State > old, current = {q};
+    /* Busca em profundidade pelas transições-épsilon; cada estado
+     * é expandido uma única vez.
+     *
+     * Para calcular o fecho de todos os estados, prefira
+     * EpsilonClosureTable (automaton/epsilonClosure.h). */
+    std::set< State > closure = {q};
+    std::vector< State > stack = {q};
 
-    while( old != current ) {
-        old = current;
-        for( State s : old )
-            setUnion( current, epsilonMove(s) );
+    while( !stack.empty() ) {
+        State s = stack.back();
+        stack.pop_back();
+        for( const State& r : delta.epsilonSuccessors( s ) )
+            if( closure.insert( r ).second )
+                stack.push_back( r );
     }
-    return current;
+    return closure;
 }
 
 template< typename State, typename Symbol >
 void NFAe< State, Symbol >::addTransition( State from,
         Either<Symbol, Epsilon> s, State to )
 {
-    if( delta.onDomain({from, s}) ) {
-        auto set = delta({from, s});
-        set.insert( to );
-        delta.insert({from, s}, set );
-    } else
-        delta.insert({from, s}, {to});
+    delta.add( from, s, to );
 }
 #endif // NON_DETERMINISTIC_WITH_EPSILON_H
@@ -0,0 +1,232 @@
+/* parallel.h
+ * Execução de um DenseDFA sobre uma única entrada grande, dividida
+ * entre várias threads.
+ *
+ * A execução de um DFA é inerentemente sequencial: o estado após o
+ * símbolo i depende do estado após o símbolo i-1. Entretanto, cada
+ * trecho da entrada define uma função f: Q -> Q, que leva o estado em
+ * que o autômato começa a ler o trecho ao estado em que ele termina.
+ * parallelAccepts divide a entrada em trechos contíguos, calcula a
+ * função de cada trecho numa thread e, por fim, compõe as funções:
+ *     q_final = f_k( ... f_2( f_1( q_0 ) ) )
+ * O primeiro trecho é executado apenas a partir do estado inicial.
+ *
+ * Calcular f para todos os estados custaria |Q| vezes mais que uma
+ * execução comum; porém, na prática, as execuções a partir de estados
+ * diferentes convergem rapidamente para poucos estados. Por isso, os
+ * estados são avançados em blocos, e, ao fim de cada bloco, execuções
+ * que chegaram ao mesmo estado são unificadas. Execuções em estados
+ * absorventes (como o estado morto) não precisam ser avançadas; quando
+ * resta apenas uma execução fora deles, o restante do trecho é lido
+ * como numa execução comum.
+ */
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include "automaton/dense.h"
+
+/* Determina se o autômato aceita a palavra delimitada pelo intervalo
+ * [begin, end), usando até threads threads. Caso threads seja 0, é
+ * usada a quantidade de núcleos da máquina.
+ *
+ * Entradas pequenas demais para que a divisão compense (menos que
+ * minimumParallelChunk símbolos por thread) são executadas
+ * sequencialmente, na thread atual. */
+template< typename Symbol, typename RandomAccessIterator >
+bool parallelAccepts( const DenseDFA< Symbol >&,
+                      RandomAccessIterator begin, RandomAccessIterator end,
+                      unsigned threads = 0 );
+
+/* Calcula a função de transição estendida do trecho [begin, end):
+ * o i-ésimo elemento do vetor retornado é o estado alcançado ao ler
+ * o trecho a partir do estado i (representado por i * rowSize, veja
+ * DenseDFA). */
+template< typename Symbol, typename RandomAccessIterator >
+std::vector< typename DenseDFA< Symbol >::State >
+chunkMapping( const DenseDFA< Symbol >&,
+              RandomAccessIterator begin, RandomAccessIterator end );
+
+/* Quantidade mínima de símbolos por thread em parallelAccepts. */
+constexpr std::size_t minimumParallelChunk = 1 << 16;
+
+// Implementação
+
+/* Avança K execuções simultâneas sobre o trecho [begin, end). Os estados
+ * são copiados para variáveis locais, para que o compilador possa
+ * mantê-los em registradores. */
+template< std::size_t K, typename Symbol, typename RandomAccessIterator >
+void advanceRuns( const DenseDFA< Symbol >& dfa,
+                  typename DenseDFA< Symbol >::State * runs,
+                  RandomAccessIterator begin, RandomAccessIterator end )
+{
+    typename DenseDFA< Symbol >::State q[K];
+    for( std::size_t j = 0; j < K; ++j )
+        q[j] = runs[j];
+    for( ; begin != end; ++begin )
+        for( std::size_t j = 0; j < K; ++j )
+            q[j] = dfa.next( q[j], *begin );
+    for( std::size_t j = 0; j < K; ++j )
+        runs[j] = q[j];
+}
+
+template< typename Symbol, typename RandomAccessIterator >
+std::vector< typename DenseDFA< Symbol >::State >
+chunkMapping( const DenseDFA< Symbol >& dfa,
+              RandomAccessIterator begin, RandomAccessIterator end )
+{
+    typedef typename DenseDFA< Symbol >::State State;
+    const unsigned rowSize = DenseDFA< Symbol >::rowSize;
+    std::size_t n = dfa.size();
+
+    /* Estados absorventes (como o estado morto) transitam apenas para
+     * si mesmos; execuções que os alcançam não precisam mais ser
+     * avançadas, e não impedem que as demais sejam consideradas
+     * convergentes. absorbing[q] é calculado sob demanda: -1 indica
+     * que o estado q ainda não foi testado. */
+    std::vector< signed char > absorbing( n, -1 );
+    auto isAbsorbing = [&]( State q ) {
+        signed char& a = absorbing[q / rowSize];
+        if( a == -1 ) {
+            a = 1;
+            for( unsigned c = 0; c < rowSize; ++c )
+                if( dfa.next( q, Symbol( c ) ) != q ) {
+                    a = 0;
+                    break;
+                }
+        }
+        return a == 1;
+    };
+
+    /* active contém os estados atuais das execuções distintas, e
+     * run[i] é a execução que começou no estado i. live é a quantidade
+     * de execuções em estados não absorventes. */
+    std::vector< State > active( n );
+    std::vector< std::size_t > run( n );
+    std::size_t live = 0;
+    for( std::size_t i = 0; i < n; ++i ) {
+        active[i] = i * rowSize;
+        run[i] = i;
+        live += !isAbsorbing( active[i] );
+    }
+
+    /* slot[q] é a posição do estado q no novo vetor active durante a
+     * unificação, ou -1. */
+    std::vector< int > slot( n, -1 );
+    std::vector< State > merged, current;
+    std::vector< std::size_t > renamed;
+
+    std::size_t block = 32;
+    while( begin != end && live > 1 ) {
+        RandomAccessIterator blockEnd = end - begin > std::ptrdiff_t(block) ?
+                                        begin + block : end;
+        /* As execuções avançam juntas, símbolo a símbolo: as cadeias de
+         * acessos à tabela são independentes, e o processador pode
+         * executá-las simultaneamente. */
+        current.clear();
+        for( State q : active )
+            if( absorbing[q / rowSize] != 1 )
+                current.push_back( q );
+        switch( current.size() ) {
+            case 2: advanceRuns< 2 >( dfa, current.data(), begin, blockEnd );
+                    break;
+            case 3: advanceRuns< 3 >( dfa, current.data(), begin, blockEnd );
+                    break;
+            case 4: advanceRuns< 4 >( dfa, current.data(), begin, blockEnd );
+                    break;
+            default:
+                for( RandomAccessIterator it = begin; it != blockEnd; ++it )
+                    for( State& q : current )
+                        q = dfa.next( q, *it );
+        }
+        begin = blockEnd;
+        std::size_t j = 0;
+        for( State& q : active )
+            if( absorbing[q / rowSize] != 1 )
+                q = current[j++];
+
+        merged.clear();
+        renamed.resize( active.size() );
+        live = 0;
+        for( std::size_t j = 0; j < active.size(); ++j ) {
+            int& s = slot[active[j] / rowSize];
+            if( s == -1 ) {
+                s = merged.size();
+                merged.push_back( active[j] );
+                live += !isAbsorbing( active[j] );
+            }
+            renamed[j] = s;
+        }
+        for( State q : merged )
+            slot[q / rowSize] = -1;
+        for( std::size_t& r : run )
+            r = renamed[r];
+        active.swap( merged );
+
+        block = std::min< std::size_t >( 2 * block, 4096 );
+    }
+
+    // Uma única execução restante: leitura comum.
+    if( live == 1 )
+        for( State& r : active )
+            if( !isAbsorbing( r ) ) {
+                State q = r;
+                for( ; begin != end; ++begin )
+                    q = dfa.next( q, *begin );
+                r = q;
+            }
+
+    std::vector< State > mapping( n );
+    for( std::size_t i = 0; i < n; ++i )
+        mapping[i] = active[run[i]];
+    return mapping;
+}
+
+template< typename Symbol, typename RandomAccessIterator >
+bool parallelAccepts( const DenseDFA< Symbol >& dfa,
+                      RandomAccessIterator begin, RandomAccessIterator end,
+                      unsigned threads )
+{
+    typedef typename DenseDFA< Symbol >::State State;
+    if( threads == 0 )
+        threads = std::max( 1u, std::thread::hardware_concurrency() );
+
+    std::size_t length = end - begin;
+    std::size_t k = std::min< std::size_t >( threads,
+                        length / minimumParallelChunk );
+    if( k <= 1 )
+        return dfa.accepts( begin, end );
+
+    /* O trecho 0 é executado pela thread atual, a partir do estado
+     * inicial; os demais calculam suas funções de transição. */
+    std::vector< std::vector< State > > mappings( k );
+    std::vector< std::thread > workers;
+    auto chunkBegin = [&]( std::size_t i ) {
+        return begin + length / k * i;
+    };
+    for( std::size_t i = 1; i < k; ++i ) {
+        RandomAccessIterator b = chunkBegin( i );
+        RandomAccessIterator e = i + 1 < k ? chunkBegin( i + 1 ) : end;
+        workers.emplace_back( [&dfa, &mappings, i, b, e]() {
+            mappings[i] = chunkMapping( dfa, b, e );
+        } );
+    }
+
+    State q = dfa.initialState();
+    for( RandomAccessIterator it = begin, e = chunkBegin( 1 ); it != e; ++it )
+        q = dfa.next( q, *it );
+
+    for( std::thread& worker : workers )
+        worker.join();
+
+    /* Como o estado no início do primeiro trecho é conhecido, compor
+     * as funções se resume a uma consulta por trecho. */
+    for( std::size_t i = 1; i < k; ++i )
+        q = mappings[i][q / DenseDFA< Symbol >::rowSize];
+    return dfa.isFinal( q );
+}
+
+#endif // PARALLEL_H
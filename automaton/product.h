@@ -0,0 +1,163 @@
+/* product.h
+ * Exploração sob demanda do produto de dois autômatos finitos
+ * determinísticos.
+ *
+ * simultaneousRun (automaton/closureProperties.h) constrói todos os
+ * pares de estados, alcançáveis ou não. Para decidir emptiness,
+ * inclusão ou disjunção, basta saber se algum par alcançável satisfaz
+ * certo predicado: aqui os pares são descobertos numa busca em largura
+ * a partir do par inicial, recebem números inteiros na ordem da
+ * descoberta, e a busca termina no primeiro par que satisfaça o
+ * predicado. Como a busca é em largura, a palavra que leva até este
+ * par é uma das menores palavras com esta propriedade.
+ */
+#ifndef PRODUCT_H
+#define PRODUCT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "automaton/deterministic.h"
+
+/* Numera os elementos de values na ordem em que aparecem, a partir
+ * de 0. Usada para indexar estados e símbolos em tabelas como a
+ * abaixo e SuccessorTable (automaton/successorTable.h). */
+template< typename Container >
+std::map< typename Container::value_type, int > numbering(
+        const Container& values );
+
+/* Tabela de transições de um DFA sobre a lista de símbolos passada.
+ * Os estados são numerados na ordem de dfa.states; o estado n é um
+ * estado de rejeição implícito, destino das transições ausentes e dos
+ * símbolos que não pertencem ao alfabeto do autômato. */
+template< typename Symbol >
+struct TransitionTable {
+    template< typename State >
+    TransitionTable( const DFA< State, Symbol >&,
+                     const std::vector< Symbol >& symbols );
+
+    int n; // Quantidade de estados, sem contar o estado de rejeição
+    int initialState;
+    std::vector< int > next; // [q*k + a], para 0 <= q <= n
+    std::vector< bool > isFinal; // [q], para 0 <= q <= n
+};
+
+/* Armazena em word a palavra que leva até o item i de uma busca em
+ * largura. parent[j] é o item a partir do qual j foi descoberto, ou um
+ * valor negativo para o item inicial, e via[j] é a posição, em symbols,
+ * do símbolo usado nesta descoberta. */
+template< typename Symbol >
+void reconstructWord( int i, const std::vector< int >& parent,
+                      const std::vector< int >& via,
+                      const std::vector< Symbol >& symbols,
+                      std::vector< Symbol >& word );
+
+/* Procura, entre os pares alcançáveis do produto de M1 e M2, um par
+ * (q1, q2) tal que pred( q1 é final, q2 é final ) seja verdadeiro.
+ * Caso exista, retorna true e armazena em word uma palavra de tamanho
+ * mínimo que leva até ele; caso contrário, retorna false e esvazia word.
+ *
+ * O alfabeto do produto é a união dos alfabetos dos dois autômatos. */
+template< typename State1, typename State2, typename Symbol, typename Pred >
+bool findInProduct( const DFA< State1, Symbol >& M1,
+                    const DFA< State2, Symbol >& M2,
+                    Pred pred, std::vector< Symbol >& word );
+
+
+// Implementação
+template< typename Container >
+std::map< typename Container::value_type, int > numbering(
+        const Container& values )
+{
+    std::map< typename Container::value_type, int > index;
+    for( const auto& v : values )
+        index.insert( index.end(), {v, (int) index.size()} );
+    return index;
+}
+
+template< typename Symbol >
+template< typename State >
+TransitionTable< Symbol >::TransitionTable( const DFA< State, Symbol >& dfa,
+        const std::vector< Symbol >& symbols )
+{
+    std::size_t k = symbols.size();
+    std::map< State, int > index = numbering( dfa.states );
+    std::map< Symbol, int > symbolIndex = numbering( symbols );
+
+    n = index.size();
+    initialState = index.at( dfa.initialState );
+    next.assign( (n + 1) * k, n );
+    isFinal.assign( n + 1, false );
+    for( const auto& pair : dfa.delta ) {
+        auto it = symbolIndex.find( pair.first.second );
+        if( it != symbolIndex.end() )
+            next[index.at( pair.first.first ) * k + it->second] =
+                index.at( pair.second );
+    }
+    for( const State& q : dfa.finalStates )
+        isFinal[index.at( q )] = true;
+}
+
+template< typename Symbol >
+void reconstructWord( int i, const std::vector< int >& parent,
+                      const std::vector< int >& via,
+                      const std::vector< Symbol >& symbols,
+                      std::vector< Symbol >& word )
+{
+    word.clear();
+    for( ; parent[i] >= 0; i = parent[i] )
+        word.push_back( symbols[via[i]] );
+    std::reverse( word.begin(), word.end() );
+}
+
+template< typename State1, typename State2, typename Symbol, typename Pred >
+bool findInProduct( const DFA< State1, Symbol >& M1,
+                    const DFA< State2, Symbol >& M2,
+                    Pred pred, std::vector< Symbol >& word )
+{
+    std::set< Symbol > alphabet = M1.alphabet;
+    alphabet.insert( M2.alphabet.begin(), M2.alphabet.end() );
+    std::vector< Symbol > symbols( alphabet.begin(), alphabet.end() );
+    std::size_t k = symbols.size();
+    TransitionTable< Symbol > t1( M1, symbols ), t2( M2, symbols );
+
+    /* O par (q1, q2) é identificado pela chave q1 * (n2 + 1) + q2;
+     * ids associa cada chave ao número do par, atribuído na ordem da
+     * descoberta. pairs[i] é o i-ésimo par descoberto, e parent[i] e
+     * via[i] são o par e o símbolo pelos quais ele foi descoberto. */
+    std::uint64_t width = t2.n + 1;
+    std::unordered_map< std::uint64_t, int > ids;
+    std::vector< std::pair< int, int > > pairs;
+    std::vector< int > parent, via;
+
+    word.clear();
+    auto discover = [&]( int q1, int q2, int from, int a ) {
+        if( !ids.insert({ q1 * width + q2, (int) pairs.size() }).second )
+            return false;
+        pairs.push_back({ q1, q2 });
+        parent.push_back( from );
+        via.push_back( a );
+        if( !pred( t1.isFinal[q1], t2.isFinal[q2] ) )
+            return false;
+
+        reconstructWord( pairs.size() - 1, parent, via, symbols, word );
+        return true;
+    };
+
+    if( discover( t1.initialState, t2.initialState, -1, -1 ) )
+        return true;
+    // pairs funciona como a fila da busca em largura.
+    for( std::size_t i = 0; i < pairs.size(); ++i ) {
+        int q1 = pairs[i].first, q2 = pairs[i].second;
+        for( std::size_t a = 0; a < k; ++a )
+            if( discover( t1.next[q1 * k + a], t2.next[q2 * k + a], i, a ) )
+                return true;
+    }
+    return false;
+}
+
+#endif // PRODUCT_H
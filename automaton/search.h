@@ -0,0 +1,199 @@
+/* search.h
+ * Busca, num texto, das ocorrências de uma linguagem regular, com
+ * a semântica "mais à esquerda, mais longa" do POSIX.
+ *
+ * Testar o autômato a partir de cada posição do texto custa tempo
+ * quadrático. Searcher usa três autômatos preguiçosos (LazyDFA), todos
+ * obtidos do mesmo NFAe:
+ *  - o autômato não-ancorado de L (isto é, de Σ*L), que, numa única
+ *    leitura do texto, marca as posições em que alguma ocorrência termina;
+ *  - o autômato não-ancorado do reverso de L (automataReversion), que,
+ *    numa única leitura do texto de trás para frente, marca as posições
+ *    em que alguma ocorrência começa;
+ *  - o autômato ancorado de L, que, a partir do início de uma ocorrência,
+ *    encontra o seu fim mais distante.
+ * A leitura reversa começa no último fim encontrado pela primeira
+ * leitura, e a leitura ancorada termina nele, ou assim que nenhuma
+ * continuação puder ser aceita.
+ *
+ * Sem outros cuidados, as leituras ancoradas custariam tempo quadrático:
+ * para L = a|a*c, num texto com n letras a, cada uma das n ocorrências
+ * (de tamanho 1) seria seguida de uma leitura até o fim do texto. Como
+ * em "Maximal-munch tokenization in linear time" (Reps), guardamos os
+ * pares (posição, estado) pelos quais uma leitura ancorada passou após
+ * o seu último fim aceito: a partir deles, nenhuma posição é aceita.
+ * Uma leitura posterior que chegue a um destes pares termina ali. Cada
+ * par é guardado no máximo uma vez; assim, as leituras ancoradas leem,
+ * ao todo, O(n·m) símbolos, em que m é a quantidade de estados
+ * visitados do autômato ancorado.
+ *
+ * As ocorrências retornadas não se sobrepõem: cada busca recomeça no
+ * fim da ocorrência anterior (ou na posição seguinte, caso a ocorrência
+ * anterior seja vazia).
+ */
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "automaton/closureProperties.h"
+#include "automaton/lazyDeterministic.h"
+#include "automaton/nonDeterministicWithEpsilon.h"
+
+/* Ocorrência no texto, delimitada pelas posições [begin, end). */
+struct Span {
+    std::size_t begin;
+    std::size_t end;
+};
+
+inline bool operator==( const Span& lhs, const Span& rhs ) {
+    return lhs.begin == rhs.begin && lhs.end == rhs.end;
+}
+
+template< typename Char >
+class Searcher {
+public:
+    /* Prepara a busca pela linguagem do autômato passado.
+     *
+     * memoryBudget é a quantidade aproximada de bytes que a cache de
+     * cada um dos três autômatos preguiçosos pode ocupar.
+     *
+     * Os estados do autômato devem ser {0, 1, ..., n-1}, como no autômato
+     * retornado por thompson(); caso contrário, std::domain_error
+     * é lançado. */
+    explicit Searcher( const NFAe< int, Char >&,
+                       std::size_t memoryBudget = 1 << 20 );
+
+    /* Procura a ocorrência mais à esquerda (e, dentre estas, a mais
+     * longa) no texto delimitado pelo intervalo [begin, end).
+     * Retorna false caso não haja nenhuma ocorrência. */
+    template< typename RandomAccessIterator >
+    bool search( RandomAccessIterator begin, RandomAccessIterator end,
+                 Span& match );
+
+    /* Retorna todas as ocorrências, sem sobreposições, da esquerda para
+     * a direita, no texto delimitado pelo intervalo [begin, end). */
+    template< typename RandomAccessIterator >
+    std::vector< Span > findAll( RandomAccessIterator begin,
+                                 RandomAccessIterator end );
+
+private:
+    typedef typename LazyDFA< Char >::Mode Mode;
+
+    LazyDFA< Char > forward; // Σ*L
+    LazyDFA< Char > backward; // Σ*reverso(L)
+    LazyDFA< Char > anchored; // L
+
+    /* Retorna até limit ocorrências, como em findAll. */
+    template< typename RandomAccessIterator >
+    std::vector< Span > find( RandomAccessIterator begin,
+                              RandomAccessIterator end, std::size_t limit );
+};
+
+// Implementação
+
+template< typename Char >
+Searcher< Char >::Searcher( const NFAe< int, Char >& nfae,
+                            std::size_t memoryBudget ) :
+    forward( nfae, memoryBudget, Mode::Unanchored ),
+    /* automataReversion acrescenta o estado n ao autômato, que continua,
+     * portanto, compacto. */
+    backward( automataReversion( nfae ), memoryBudget, Mode::Unanchored ),
+    anchored( nfae, memoryBudget, Mode::Anchored )
+{}
+
+template< typename Char >
+template< typename RandomAccessIterator >
+bool Searcher< Char >::search( RandomAccessIterator begin,
+                               RandomAccessIterator end, Span& match )
+{
+    std::vector< Span > spans = find( begin, end, 1 );
+    if( spans.empty() )
+        return false;
+    match = spans[0];
+    return true;
+}
+
+template< typename Char >
+template< typename RandomAccessIterator >
+std::vector< Span > Searcher< Char >::findAll( RandomAccessIterator begin,
+                                               RandomAccessIterator end )
+{
+    return find( begin, end, std::numeric_limits< std::size_t >::max() );
+}
+
+template< typename Char >
+template< typename RandomAccessIterator >
+std::vector< Span > Searcher< Char >::find( RandomAccessIterator begin,
+        RandomAccessIterator end, std::size_t limit )
+{
+    std::vector< Span > spans;
+    std::size_t size = end - begin;
+
+    // Fins das ocorrências: prefixos do texto aceitos por Σ*L.
+    bool found = false;
+    std::size_t lastEnd = 0;
+    forward.scan( begin, end, [&]( std::size_t i ) {
+        found = true;
+        lastEnd = i;
+    });
+    if( !found )
+        return spans;
+
+    /* Inícios das ocorrências: sufixos de [begin, begin + lastEnd)
+     * cujo reverso tem um prefixo em reverso(L). */
+    std::vector< bool > isStart( size + 1, false );
+    typedef std::reverse_iterator< RandomAccessIterator > ReverseIterator;
+    backward.scan( ReverseIterator( begin + lastEnd ), ReverseIterator( begin ),
+                   [&]( std::size_t i ) { isStart[lastEnd - i] = true; } );
+
+    /* failed[p] contém os estados do autômato ancorado a partir dos
+     * quais, na posição p, nenhuma posição até lastEnd é aceita; trail
+     * contém os pares visitados pela leitura atual. Como os números dos
+     * estados mudam quando a cache é esvaziada, ambos são descartados
+     * neste caso. */
+    std::unordered_map< std::size_t, std::vector< int > > failed;
+    std::vector< std::pair< std::size_t, int > > trail;
+    std::size_t generation = anchored.statistics().flushes;
+
+    std::size_t cursor = 0;
+    while( spans.size() < limit ) {
+        while( cursor <= lastEnd && !isStart[cursor] )
+            ++cursor;
+        if( cursor > lastEnd )
+            break;
+
+        /* Há uma ocorrência começando em cursor; ela termina,
+         * no máximo, em lastEnd. */
+        std::size_t longest = cursor;
+        trail.clear();
+        anchored.scan( begin + cursor, begin + lastEnd,
+            [&]( std::size_t i ) { longest = cursor + i; },
+            [&]( std::size_t i, int q ) {
+                if( anchored.statistics().flushes != generation ) {
+                    generation = anchored.statistics().flushes;
+                    failed.clear();
+                    trail.clear();
+                }
+                auto it = failed.find( cursor + i );
+                if( it != failed.end() && std::find( it->second.begin(),
+                            it->second.end(), q ) != it->second.end() )
+                    return false;
+                trail.push_back({ cursor + i, q });
+                return true;
+            });
+        for( const auto& pair : trail )
+            if( pair.first > longest )
+                failed[pair.first].push_back( pair.second );
+        spans.push_back({ cursor, longest });
+        cursor = longest > cursor ? longest : cursor + 1;
+    }
+    return spans;
+}
+
+#endif // SEARCH_H
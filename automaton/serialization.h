@@ -0,0 +1,557 @@
+/* serialization.h
+ * Formato binário para autômatos compactos, que pode ser usado
+ * diretamente a partir de um arquivo mapeado em memória.
+ *
+ * Construir e minimizar autômatos grandes a cada execução do programa
+ * é caro. serialize() grava um DFA ou NFA compacto num formato binário
+ * de tamanho fixo por estado; MappedDFA e MappedNFA executam o autômato
+ * diretamente sobre os bytes gravados, sem convertê-los e sem alocar
+ * memória por estado. Com MappedFile (utility/mappedFile.h), carregar
+ * o autômato custa apenas o mapeamento, e as páginas são compartilhadas
+ * entre os processos que o usam.
+ *
+ * O formato (versão 1) é composto apenas de inteiros de 32 bits sem
+ * sinal, em little-endian:
+ *
+ *  Cabeçalho:
+ *      magic       Os bytes "AUTM"
+ *      version     1
+ *      kind        0 para DFA, 1 para NFA
+ *      symbolSize  sizeof(Symbol)
+ *      states      n
+ *      symbols     k
+ *      initial     Estado inicial (indefinido se n = 0)
+ *      targets     Quantidade de destinos do NFA (0 para DFA)
+ *      payload     Tamanho, em bytes, do restante do arquivo
+ *      checksum    FNV-1a de 32 bits do restante do arquivo
+ *  Símbolos:
+ *      k símbolos, em ordem crescente do seu valor sem sinal; a coluna
+ *      do símbolo na tabela é a sua posição nesta lista.
+ *  Transições (DFA):
+ *      n*k destinos; rows[q*k + a] é o destino de q pelo símbolo a,
+ *      ou 0xFFFFFFFF se a transição for indefinida.
+ *  Transições (NFA):
+ *      n*k + 1 deslocamentos, seguidos de targets destinos; os destinos
+ *      de q por a ocupam as posições [begin[q*k + a], begin[q*k + a + 1]).
+ *  Estados finais:
+ *      (n + 31) / 32 palavras; o bit q % 32 da palavra q / 32 indica se
+ *      q é final.
+ *
+ * As leituras são feitas byte a byte (o compilador as converte em
+ * leituras simples em máquinas little-endian), de modo que o buffer não
+ * precisa estar alinhado.
+ *
+ * Apenas símbolos inteiros de até 32 bits são suportados.
+ */
+#ifndef SERIALIZATION_H
+#define SERIALIZATION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "exceptions.h"
+#include "automaton/deterministic.h"
+#include "automaton/nonDeterministic.h"
+#include "utility/bitset.h"
+
+/* Grava o autômato passado em out, no formato descrito acima.
+ *
+ * O autômato deve ser compacto (veja automaton/compaction.h); caso
+ * contrário, std::domain_error é lançado. */
+template< typename Symbol >
+void serialize( const DFA< int, Symbol >&, std::ostream& out );
+template< typename Symbol >
+void serialize( const NFA< int, Symbol >&, std::ostream& out );
+
+/* Autômato determinístico gravado por serialize, lido diretamente do
+ * buffer [data, data + size), que deve existir enquanto este objeto
+ * for usado.
+ *
+ * Caso verify seja verdadeiro, o checksum e todos os índices são
+ * conferidos na construção, em tempo proporcional ao tamanho do buffer;
+ * caso contrário, apenas o cabeçalho é conferido, e o buffer deve ser
+ * confiável.
+ *
+ * Exceção lançada:
+ *  serialization_error - caso o buffer não contenha um DFA válido
+ *                        sobre símbolos do tamanho de Symbol. */
+template< typename Symbol >
+class MappedDFA {
+public:
+    /* Marca de transição indefinida. */
+    static constexpr std::uint32_t none = 0xFFFFFFFF;
+
+    MappedDFA( const void * data, std::size_t size, bool verify = true );
+
+    /* Determina se o autômato aceita ou não a palavra delimitada
+     * pelo intervalo [begin, end). */
+    template< typename ForwardIterator >
+    bool accepts( ForwardIterator begin, ForwardIterator end ) const;
+
+    /* Estado inicial, transição (none, se indefinida) e teste de estado
+     * final, para execuções passo a passo. */
+    std::uint32_t initialState() const;
+    std::uint32_t next( std::uint32_t q, Symbol a ) const;
+    bool isFinal( std::uint32_t q ) const;
+
+    /* Quantidade de estados. */
+    std::size_t size() const;
+
+    /* Reconstrói o autômato gravado. */
+    DFA< int, Symbol > toDFA() const;
+
+private:
+    const unsigned char * symbols;
+    const unsigned char * rows;
+    const unsigned char * finals;
+    std::uint32_t n, k, initial;
+    int byteIndex[256]; // Coluna de cada byte, para símbolos de um byte
+
+    int column( Symbol ) const;
+};
+
+/* Autômato não-determinístico gravado por serialize; veja MappedDFA. */
+template< typename Symbol >
+class MappedNFA {
+public:
+    MappedNFA( const void * data, std::size_t size, bool verify = true );
+
+    /* Determina se o autômato aceita ou não a palavra delimitada
+     * pelo intervalo [begin, end), simulando o conjunto de estados. */
+    template< typename ForwardIterator >
+    bool accepts( ForwardIterator begin, ForwardIterator end ) const;
+
+    /* Quantidade de estados. */
+    std::size_t size() const;
+
+    /* Reconstrói o autômato gravado. */
+    NFA< int, Symbol > toNFA() const;
+
+private:
+    const unsigned char * symbols;
+    const unsigned char * begins;
+    const unsigned char * targets;
+    const unsigned char * finals;
+    std::uint32_t n, k, initial;
+    int byteIndex[256];
+
+    int column( Symbol ) const;
+};
+
+// Implementação
+
+namespace Serialization {
+
+constexpr std::uint32_t version = 1;
+constexpr std::uint32_t none = 0xFFFFFFFF;
+constexpr std::size_t headerSize = 40;
+
+enum class Kind : std::uint32_t { Deterministic = 0, NonDeterministic = 1 };
+
+/* Campos do cabeçalho, na ordem em que são gravados (após magic). */
+struct Header {
+    std::uint32_t version, kind, symbolSize, states, symbols, initial,
+                  targets, payload, checksum;
+};
+
+inline std::uint32_t load32( const unsigned char * p ) {
+    return std::uint32_t(p[0]) | std::uint32_t(p[1]) << 8 |
+           std::uint32_t(p[2]) << 16 | std::uint32_t(p[3]) << 24;
+}
+
+inline void store32( std::string& out, std::uint32_t x ) {
+    for( int i = 0; i < 4; ++i )
+        out.push_back( char( x >> (8 * i) & 0xFF ) );
+}
+
+inline std::uint32_t checksum( const unsigned char * p, std::size_t size ) {
+    std::uint32_t h = 2166136261u;
+    for( std::size_t i = 0; i < size; ++i )
+        h = (h ^ p[i]) * 16777619u;
+    return h;
+}
+
+/* Valor sem sinal do símbolo, usado na ordenação e na gravação. */
+template< typename Symbol >
+std::uint32_t encode( Symbol a ) {
+    static_assert( std::is_integral< Symbol >::value && sizeof(Symbol) <= 4,
+        "Serialization supports only integral symbols up to 32 bits" );
+    return typename std::make_unsigned< Symbol >::type( a );
+}
+
+/* Símbolos do alfabeto, em ordem crescente de valor sem sinal. */
+template< typename Symbol >
+std::vector< std::pair< std::uint32_t, Symbol > >
+sortedSymbols( const std::set< Symbol >& alphabet ) {
+    std::vector< std::pair< std::uint32_t, Symbol > > v;
+    for( Symbol a : alphabet )
+        v.push_back({ encode( a ), a });
+    std::sort( v.begin(), v.end() );
+    return v;
+}
+
+template< typename State >
+void checkCompact( const std::set< State >& states ) {
+    std::size_t n = states.size();
+    if( n > 0 && ( *states.begin() != 0 || *states.rbegin() != int(n - 1) ) )
+        throw std::domain_error( "Automaton is not compact." );
+}
+
+/* Grava o cabeçalho e o restante do arquivo. */
+inline void write( std::ostream& out, Kind kind, std::uint32_t symbolSize,
+        std::uint32_t states, std::uint32_t symbols, std::uint32_t initial,
+        std::uint32_t targets, const std::string& payload )
+{
+    std::string header = "AUTM";
+    for( std::uint32_t x : { version, std::uint32_t(kind), symbolSize, states,
+            symbols, initial, targets, std::uint32_t(payload.size()),
+            checksum( (const unsigned char *) payload.data(),
+                      payload.size() ) } )
+        store32( header, x );
+    out.write( header.data(), header.size() );
+    out.write( payload.data(), payload.size() );
+}
+
+inline void writeFinals( std::string& payload, const std::set< int >& finals,
+                         std::size_t n )
+{
+    std::vector< std::uint32_t > words( (n + 31) / 32, 0 );
+    for( int q : finals )
+        words[q / 32] |= std::uint32_t(1) << (q % 32);
+    for( std::uint32_t w : words )
+        store32( payload, w );
+}
+
+/* Lê e confere o cabeçalho, inclusive se o tamanho do restante do
+ * arquivo é compatível com as quantidades de estados e de símbolos. */
+inline Header readHeader( const void * data, std::size_t size, Kind kind,
+                          std::uint32_t symbolSize, bool verify )
+{
+    const unsigned char * p = static_cast< const unsigned char * >( data );
+    if( size < headerSize || std::memcmp( p, "AUTM", 4 ) != 0 )
+        throw serialization_error( "Not a serialized automaton." );
+    Header h;
+    std::uint32_t * fields[] = { &h.version, &h.kind, &h.symbolSize,
+        &h.states, &h.symbols, &h.initial, &h.targets, &h.payload,
+        &h.checksum };
+    for( std::size_t i = 0; i < 9; ++i )
+        *fields[i] = load32( p + 4 * (i + 1) );
+
+    if( h.version != version )
+        throw serialization_error( "Unsupported serialization version." );
+    if( h.kind != std::uint32_t(kind) )
+        throw serialization_error( "Wrong automaton kind." );
+    if( h.symbolSize != symbolSize )
+        throw serialization_error( "Wrong symbol size." );
+    if( h.payload != size - headerSize )
+        throw serialization_error( "Wrong payload size." );
+
+    std::uint64_t cells = std::uint64_t(h.states) * h.symbols;
+    std::uint64_t words = h.symbols + (h.states + 31) / 32 +
+        (kind == Kind::Deterministic ? cells : cells + 1 + h.targets);
+    if( words * 4 != h.payload )
+        throw serialization_error( "Inconsistent payload size." );
+    if( h.states > 0 && h.initial >= h.states )
+        throw serialization_error( "Invalid initial state." );
+    if( verify && checksum( p + headerSize, h.payload ) != h.checksum )
+        throw serialization_error( "Checksum mismatch." );
+    return h;
+}
+
+/* Confere se os símbolos estão em ordem estritamente crescente e
+ * preenche byteIndex, para símbolos de um byte. */
+template< typename Symbol >
+void readSymbols( const unsigned char * symbols, std::uint32_t k,
+                  int (&byteIndex)[256], bool verify )
+{
+    for( int& i : byteIndex )
+        i = -1;
+    for( std::uint32_t a = 0; a < k; ++a ) {
+        std::uint32_t value = load32( symbols + 4 * a );
+        if( verify && a > 0 && value <= load32( symbols + 4 * (a - 1) ) )
+            throw serialization_error( "Symbols out of order." );
+        if( sizeof(Symbol) == 1 ) {
+            if( value > 0xFF )
+                throw serialization_error( "Symbol out of range." );
+            byteIndex[value] = a;
+        }
+    }
+}
+
+/* Coluna do símbolo a, ou -1 caso ele não pertença ao alfabeto. */
+template< typename Symbol >
+int column( const unsigned char * symbols, std::uint32_t k,
+            const int (&byteIndex)[256], Symbol a )
+{
+    std::uint32_t value = encode( a );
+    if( sizeof(Symbol) == 1 )
+        return byteIndex[value];
+    std::uint32_t low = 0, high = k;
+    while( low < high ) {
+        std::uint32_t mid = low + (high - low) / 2;
+        if( load32( symbols + 4 * mid ) < value )
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low < k && load32( symbols + 4 * low ) == value ? int(low) : -1;
+}
+
+inline bool isFinal( const unsigned char * finals, std::uint32_t q ) {
+    return load32( finals + 4 * (q / 32) ) >> (q % 32) & 1;
+}
+
+} // namespace Serialization
+
+template< typename Symbol >
+void serialize( const DFA< int, Symbol >& dfa, std::ostream& out ) {
+    using namespace Serialization;
+    checkCompact( dfa.states );
+    std::size_t n = dfa.states.size();
+    auto symbols = sortedSymbols( dfa.alphabet );
+
+    std::string payload;
+    for( const auto& pair : symbols )
+        store32( payload, pair.first );
+    for( std::size_t q = 0; q < n; ++q )
+        for( const auto& pair : symbols )
+            store32( payload, dfa.delta.onDomain({ int(q), pair.second }) ?
+                              dfa.delta({ int(q), pair.second }) : none );
+    writeFinals( payload, dfa.finalStates, n );
+
+    write( out, Kind::Deterministic, sizeof(Symbol), n, symbols.size(),
+           n > 0 ? dfa.initialState : none, 0, payload );
+}
+
+template< typename Symbol >
+void serialize( const NFA< int, Symbol >& nfa, std::ostream& out ) {
+    using namespace Serialization;
+    checkCompact( nfa.states );
+    std::size_t n = nfa.states.size();
+    auto symbols = sortedSymbols( nfa.alphabet );
+
+    std::string payload, targets;
+    std::uint32_t count = 0;
+    for( const auto& pair : symbols )
+        store32( payload, pair.first );
+    for( std::size_t q = 0; q < n; ++q )
+        for( const auto& pair : symbols ) {
+            store32( payload, count );
+            if( !nfa.delta.onDomain({ int(q), pair.second }) )
+                continue;
+            for( int r : nfa.delta({ int(q), pair.second }) ) {
+                store32( targets, r );
+                ++count;
+            }
+        }
+    store32( payload, count );
+    payload += targets;
+    writeFinals( payload, nfa.finalStates, n );
+
+    write( out, Kind::NonDeterministic, sizeof(Symbol), n, symbols.size(),
+           n > 0 ? nfa.initialState : none, count, payload );
+}
+
+template< typename Symbol >
+constexpr std::uint32_t MappedDFA< Symbol >::none;
+
+template< typename Symbol >
+MappedDFA< Symbol >::MappedDFA( const void * data, std::size_t size,
+                                bool verify )
+{
+    using namespace Serialization;
+    Header h = readHeader( data, size, Kind::Deterministic,
+                           sizeof(Symbol), verify );
+    n = h.states;
+    k = h.symbols;
+    initial = h.initial;
+    symbols = static_cast< const unsigned char * >( data ) + headerSize;
+    rows = symbols + 4 * std::size_t(k);
+    finals = rows + 4 * std::size_t(n) * k;
+    readSymbols< Symbol >( symbols, k, byteIndex, verify );
+
+    if( verify )
+        for( std::size_t i = 0; i < std::size_t(n) * k; ++i ) {
+            std::uint32_t r = load32( rows + 4 * i );
+            if( r != none && r >= n )
+                throw serialization_error( "Invalid transition." );
+        }
+}
+
+template< typename Symbol >
+template< typename ForwardIterator >
+bool MappedDFA< Symbol >::accepts( ForwardIterator begin,
+                                   ForwardIterator end ) const
+{
+    if( n == 0 )
+        return false;
+    std::uint32_t q = initial;
+    for( ; begin != end; ++begin ) {
+        q = next( q, *begin );
+        if( q == none )
+            return false;
+    }
+    return isFinal( q );
+}
+
+template< typename Symbol >
+std::uint32_t MappedDFA< Symbol >::initialState() const {
+    return n > 0 ? initial : none;
+}
+
+template< typename Symbol >
+std::uint32_t MappedDFA< Symbol >::next( std::uint32_t q, Symbol a ) const {
+    int c = column( a );
+    if( c < 0 )
+        return none;
+    return Serialization::load32( rows + 4 * (std::size_t(q) * k + c) );
+}
+
+template< typename Symbol >
+bool MappedDFA< Symbol >::isFinal( std::uint32_t q ) const {
+    return Serialization::isFinal( finals, q );
+}
+
+template< typename Symbol >
+std::size_t MappedDFA< Symbol >::size() const {
+    return n;
+}
+
+template< typename Symbol >
+DFA< int, Symbol > MappedDFA< Symbol >::toDFA() const {
+    using Serialization::load32;
+    DFA< int, Symbol > dfa;
+    std::vector< Symbol > alphabet;
+    for( std::uint32_t a = 0; a < k; ++a ) {
+        alphabet.push_back( Symbol( load32( symbols + 4 * a ) ) );
+        dfa.alphabet.insert( alphabet.back() );
+    }
+    for( std::uint32_t q = 0; q < n; ++q ) {
+        dfa.states.insert( q );
+        if( isFinal( q ) )
+            dfa.finalStates.insert( q );
+        for( std::uint32_t a = 0; a < k; ++a ) {
+            std::uint32_t r = load32( rows + 4 * (std::size_t(q) * k + a) );
+            if( r != none )
+                dfa.delta.insert( {int(q), alphabet[a]}, int(r) );
+        }
+    }
+    dfa.initialState = n > 0 ? initial : 0;
+    return dfa;
+}
+
+template< typename Symbol >
+int MappedDFA< Symbol >::column( Symbol a ) const {
+    return Serialization::column( symbols, k, byteIndex, a );
+}
+
+template< typename Symbol >
+MappedNFA< Symbol >::MappedNFA( const void * data, std::size_t size,
+                                bool verify )
+{
+    using namespace Serialization;
+    Header h = readHeader( data, size, Kind::NonDeterministic,
+                           sizeof(Symbol), verify );
+    n = h.states;
+    k = h.symbols;
+    initial = h.initial;
+    symbols = static_cast< const unsigned char * >( data ) + headerSize;
+    begins = symbols + 4 * std::size_t(k);
+    targets = begins + 4 * (std::size_t(n) * k + 1);
+    finals = targets + 4 * std::size_t(h.targets);
+    readSymbols< Symbol >( symbols, k, byteIndex, verify );
+
+    /* Os deslocamentos devem ser crescentes e terminar em h.targets,
+     * para que nenhuma leitura saia do buffer. */
+    std::size_t cells = std::size_t(n) * k;
+    if( load32( begins ) != 0 || load32( begins + 4 * cells ) != h.targets )
+        throw serialization_error( "Invalid transition offsets." );
+    if( verify ) {
+        for( std::size_t i = 0; i < cells; ++i )
+            if( load32( begins + 4 * i ) > load32( begins + 4 * (i + 1) ) )
+                throw serialization_error( "Invalid transition offsets." );
+        for( std::size_t i = 0; i < h.targets; ++i )
+            if( load32( targets + 4 * i ) >= n )
+                throw serialization_error( "Invalid transition." );
+    }
+}
+
+template< typename Symbol >
+template< typename ForwardIterator >
+bool MappedNFA< Symbol >::accepts( ForwardIterator begin,
+                                   ForwardIterator end ) const
+{
+    using Serialization::load32;
+    if( n == 0 )
+        return false;
+    Bitset current( n ), next( n );
+    current.set( initial );
+    for( ; begin != end; ++begin ) {
+        int a = column( *begin );
+        if( a < 0 )
+            return false;
+        next.clear();
+        current.forEach( [&]( std::size_t q ) {
+            const unsigned char * cell = begins + 4 * (q * k + a);
+            for( std::uint32_t i = load32( cell ), e = load32( cell + 4 );
+                    i < e; ++i )
+                next.set( load32( targets + 4 * i ) );
+        });
+        if( next.none() )
+            return false;
+        std::swap( current, next );
+    }
+    bool accepted = false;
+    current.forEach( [&]( std::size_t q ) {
+        accepted = accepted || Serialization::isFinal( finals, q );
+    });
+    return accepted;
+}
+
+template< typename Symbol >
+std::size_t MappedNFA< Symbol >::size() const {
+    return n;
+}
+
+template< typename Symbol >
+NFA< int, Symbol > MappedNFA< Symbol >::toNFA() const {
+    using Serialization::load32;
+    NFA< int, Symbol > nfa;
+    std::vector< Symbol > alphabet;
+    for( std::uint32_t a = 0; a < k; ++a ) {
+        alphabet.push_back( Symbol( load32( symbols + 4 * a ) ) );
+        nfa.alphabet.insert( alphabet.back() );
+    }
+    for( std::uint32_t q = 0; q < n; ++q ) {
+        nfa.states.insert( q );
+        if( Serialization::isFinal( finals, q ) )
+            nfa.finalStates.insert( q );
+        for( std::uint32_t a = 0; a < k; ++a ) {
+            const unsigned char * cell = begins + 4 * (std::size_t(q) * k + a);
+            std::uint32_t i = load32( cell ), e = load32( cell + 4 );
+            if( i == e )
+                continue;
+            std::set< int > s;
+            for( ; i < e; ++i )
+                s.insert( load32( targets + 4 * i ) );
+            nfa.delta.insert( {int(q), alphabet[a]}, s );
+        }
+    }
+    nfa.initialState = n > 0 ? initial : 0;
+    return nfa;
+}
+
+template< typename Symbol >
+int MappedNFA< Symbol >::column( Symbol a ) const {
+    return Serialization::column( symbols, k, byteIndex, a );
+}
+
+#endif // SERIALIZATION_H
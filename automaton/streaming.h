@@ -0,0 +1,149 @@
+/* streaming.h
+ * Execução incremental de um DFA sobre uma palavra que chega em
+ * pedaços, como dados lidos da rede ou de arquivos.
+ *
+ * DFA::accepts precisa da palavra inteira num único intervalo.
+ * StreamMatcher guarda o estado atual entre as chamadas: cada pedaço
+ * é passado para feed(), e finish() encerra a palavra. Assim, não é
+ * necessário acumular a palavra inteira para classificá-la.
+ *
+ * A rejeição é detectada assim que possível: a partir de um estado que
+ * não alcança nenhum estado final (ou de uma transição indefinida),
+ * nenhuma continuação da palavra será aceita, e os próximos pedaços
+ * nem precisam ser lidos.
+ */
+#ifndef STREAMING_H
+#define STREAMING_H
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <vector>
+#include "automaton/deterministic.h"
+
+template< typename State, typename Symbol >
+class StreamMatcher {
+public:
+    /* Prepara o reconhecimento de palavras com o autômato passado,
+     * que deve existir enquanto este objeto for usado. */
+    explicit StreamMatcher( const DFA< State, Symbol >& );
+
+    /* Lê o próximo pedaço da palavra, delimitado pelo intervalo
+     * [begin, end), ou contido no contêiner passado.
+     *
+     * Retorna false caso a palavra já tenha sido rejeitada; neste caso,
+     * o restante do pedaço não é lido. */
+    template< typename ForwardIterator >
+    bool feed( ForwardIterator begin, ForwardIterator end );
+    template< typename Container >
+    bool feed( const Container& );
+
+    /* Encerra a palavra atual: retorna true caso ela tenha sido aceita,
+     * e reinicia o reconhecedor para a próxima palavra. */
+    bool finish();
+
+    /* Informa se a palavra lida até agora seria aceita caso terminasse
+     * aqui, e se ela já foi rejeitada (isto é, se nenhuma continuação
+     * pode ser aceita). */
+    bool accepting() const;
+    bool rejected() const;
+
+    /* Quantidade de símbolos lidos na palavra atual. Após a rejeição,
+     * é a posição do símbolo que levou à rejeição, mais um. */
+    std::size_t consumed() const;
+
+    /* Descarta a palavra atual e volta ao estado inicial. */
+    void reset();
+
+private:
+    const DFA< State, Symbol > * dfa;
+    std::set< State > live; // Estados que alcançam algum estado final
+    State current;
+    bool dead;
+    std::size_t count;
+};
+
+// Implementação
+
+template< typename State, typename Symbol >
+StreamMatcher< State, Symbol >::StreamMatcher(
+        const DFA< State, Symbol >& dfa ) :
+    dfa( &dfa )
+{
+    /* Busca a partir dos estados finais, no grafo com as transições
+     * invertidas. */
+    std::map< State, std::vector< State > > predecessors;
+    for( const auto& pair : dfa.delta )
+        predecessors[pair.second].push_back( pair.first.first );
+
+    std::vector< State > stack( dfa.finalStates.begin(),
+                                dfa.finalStates.end() );
+    live = dfa.finalStates;
+    while( !stack.empty() ) {
+        State q = stack.back();
+        stack.pop_back();
+        for( const State& p : predecessors[q] )
+            if( live.insert( p ).second )
+                stack.push_back( p );
+    }
+    reset();
+}
+
+template< typename State, typename Symbol >
+template< typename ForwardIterator >
+bool StreamMatcher< State, Symbol >::feed( ForwardIterator begin,
+                                           ForwardIterator end )
+{
+    if( dead )
+        return false;
+    for( ; begin != end; ++begin ) {
+        ++count;
+        if( !dfa->delta.onDomain({current, *begin}) ) {
+            dead = true;
+            return false;
+        }
+        current = dfa->delta({current, *begin});
+        if( live.count( current ) == 0 ) {
+            dead = true;
+            return false;
+        }
+    }
+    return true;
+}
+
+template< typename State, typename Symbol >
+template< typename Container >
+bool StreamMatcher< State, Symbol >::feed( const Container& chunk ) {
+    return feed( chunk.begin(), chunk.end() );
+}
+
+template< typename State, typename Symbol >
+bool StreamMatcher< State, Symbol >::finish() {
+    bool r = accepting();
+    reset();
+    return r;
+}
+
+template< typename State, typename Symbol >
+bool StreamMatcher< State, Symbol >::accepting() const {
+    return !dead && dfa->finalStates.count( current ) > 0;
+}
+
+template< typename State, typename Symbol >
+bool StreamMatcher< State, Symbol >::rejected() const {
+    return dead;
+}
+
+template< typename State, typename Symbol >
+std::size_t StreamMatcher< State, Symbol >::consumed() const {
+    return count;
+}
+
+template< typename State, typename Symbol >
+void StreamMatcher< State, Symbol >::reset() {
+    current = dfa->initialState;
+    dead = live.count( current ) == 0;
+    count = 0;
+}
+
+#endif // STREAMING_H
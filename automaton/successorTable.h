@@ -0,0 +1,59 @@
+/* successorTable.h
+ * Representação de um autômato finito não determinístico por listas
+ * de adjacência, usada pelos algoritmos que percorrem conjuntos de
+ * estados sob demanda (automaton/antichains.h e
+ * automaton/bisimulation.h).
+ */
+#ifndef SUCCESSOR_TABLE_H
+#define SUCCESSOR_TABLE_H
+
+#include <map>
+#include <vector>
+#include "automaton/nonDeterministic.h"
+#include "automaton/product.h"
+#include "utility/bitset.h"
+
+/* NFA com os estados numerados na ordem de nfa.states, e os símbolos
+ * na ordem da lista passada. Os símbolos que não pertencem à lista
+ * são ignorados. */
+template< typename Symbol >
+struct SuccessorTable {
+    template< typename State >
+    SuccessorTable( const NFA< State, Symbol >&,
+                    const std::vector< Symbol >& symbols );
+
+    int n;
+    int initialState;
+    std::vector< std::vector< int > > next; // [q*k + a]
+    Bitset finalStates;
+};
+
+
+// Implementação
+template< typename Symbol >
+template< typename State >
+SuccessorTable< Symbol >::SuccessorTable( const NFA< State, Symbol >& nfa,
+        const std::vector< Symbol >& symbols ) :
+    n( nfa.states.size() ),
+    next( n * symbols.size() ),
+    finalStates( n )
+{
+    std::size_t k = symbols.size();
+    std::map< State, int > index = numbering( nfa.states );
+    std::map< Symbol, int > symbolIndex = numbering( symbols );
+
+    initialState = index.at( nfa.initialState );
+    for( const auto& pair : nfa.delta ) {
+        auto it = symbolIndex.find( pair.first.second );
+        if( it == symbolIndex.end() )
+            continue;
+        std::vector< int >& v = next[index.at( pair.first.first ) * k +
+                                     it->second];
+        for( const State& r : pair.second )
+            v.push_back( index.at( r ) );
+    }
+    for( const State& q : nfa.finalStates )
+        finalStates.set( index.at( q ) );
+}
+
+#endif // SUCCESSOR_TABLE_H
@@ -0,0 +1,274 @@
+/* transitionsWithEpsilon.h
+ * Função de transição de um autômato não determinístico com
+ * transições-épsilon.
+ *
+ * As transições por símbolo e as transições-épsilon são armazenadas
+ * separadamente: as primeiras num mapa indexado por (estado, símbolo),
+ * e as últimas em listas de adjacência ordenadas, indexadas apenas pelo
+ * estado. Assim, consultas não precisam construir nem comparar
+ * instâncias de Either, e o cálculo de fechos-épsilon não percorre as
+ * transições por símbolo.
+ *
+ * A interface de Math::Function (operator(), onDomain, insert, erase e
+ * iteração), com domínio std::pair<State, Either<Symbol, Epsilon>> e
+ * imagem std::set<State>, é mantida. A única diferença é que a iteração
+ * produz os pares por valor: primeiro as transições por símbolo, em
+ * ordem, e depois as transições-épsilon, ordenadas pelo estado.
+ */
+#ifndef TRANSITIONS_WITH_EPSILON_H
+#define TRANSITIONS_WITH_EPSILON_H
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "epsilon.h"
+#include "utility/either.h"
+
+template< typename State, typename Symbol >
+class TransitionsWithEpsilon {
+public:
+    typedef std::pair< State, Either<Symbol, Epsilon> > Key;
+    typedef std::pair< Key, std::set<State> > value_type;
+    typedef std::map< std::pair<State, Symbol>, std::set<State> >
+        SymbolTransitions;
+    typedef std::map< State, std::vector<State> > EpsilonTransitions;
+
+    class const_iterator;
+
+    /* Constrói uma função vazia. */
+    TransitionsWithEpsilon() = default;
+
+    /* Constrói a função com os pares ordenados passados. */
+    TransitionsWithEpsilon( std::initializer_list< value_type > );
+
+    /* Recupera o conjunto de estados alcançado a partir de x.first
+     * por x.second. Caso x não pertença ao domínio da função,
+     * std::domain_error é lançado. */
+    std::set< State > operator()( const Key& x ) const;
+
+    /* Retorna true caso x pertença ao domínio desta função. */
+    bool onDomain( const Key& x ) const;
+
+    /* Adiciona o mapeamento de x para fx na função, substituindo
+     * o mapeamento atual, caso exista. */
+    void insert( const Key& x, const std::set<State>& fx );
+
+    /* Exclui do domínio o valor passado. */
+    void erase( const Key& x );
+
+    /* Adiciona o estado to ao conjunto alcançado a partir de from
+     * por s. Nada é feito caso a transição já exista. */
+    void add( const State& from, const Either<Symbol, Epsilon>& s,
+              const State& to );
+
+    /* Acesso direto às duas tabelas. As listas de adjacência das
+     * transições-épsilon estão em ordem crescente e sem repetições. */
+    const SymbolTransitions& symbolTransitions() const;
+    const EpsilonTransitions& epsilonTransitions() const;
+
+    /* Estados alcançados a partir de q por uma transição-épsilon, em
+     * ordem crescente; a lista é vazia caso não haja nenhum. */
+    const std::vector< State >& epsilonSuccessors( const State& q ) const;
+
+    /* Iteração sobre os pares da função; operator* retorna value_type.
+     * O iterador é apenas de avanço. */
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    SymbolTransitions symbols;
+    EpsilonTransitions epsilons;
+};
+
+template< typename State, typename Symbol >
+class TransitionsWithEpsilon< State, Symbol >::const_iterator {
+    typename SymbolTransitions::const_iterator symbol, symbolEnd;
+    typename EpsilonTransitions::const_iterator epsilonIterator;
+
+    const_iterator( typename SymbolTransitions::const_iterator,
+                    typename SymbolTransitions::const_iterator,
+                    typename EpsilonTransitions::const_iterator );
+    friend class TransitionsWithEpsilon;
+
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename TransitionsWithEpsilon::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type * pointer;
+    typedef value_type reference;
+
+    const_iterator() = default;
+
+    value_type operator*() const;
+    const_iterator& operator++();
+    const_iterator operator++( int );
+
+    bool operator==( const const_iterator& ) const;
+    bool operator!=( const const_iterator& ) const;
+};
+
+// Implementação
+
+// Construtor
+template< typename State, typename Symbol >
+TransitionsWithEpsilon< State, Symbol >::TransitionsWithEpsilon(
+        std::initializer_list< value_type > list )
+{
+    for( const value_type& pair : list )
+        insert( pair.first, pair.second );
+}
+
+// Consultas
+template< typename State, typename Symbol >
+std::set< State > TransitionsWithEpsilon< State, Symbol >::operator()(
+        const Key& x ) const
+{
+    if( x.second.template is< Epsilon >() ) {
+        auto it = epsilons.find( x.first );
+        if( it != epsilons.end() )
+            return std::set< State >( it->second.begin(), it->second.end() );
+    } else {
+        auto it = symbols.find({ x.first, x.second.template getAs<Symbol>() });
+        if( it != symbols.end() )
+            return it->second;
+    }
+    throw std::domain_error( "Element is not in domain of function." );
+}
+
+template< typename State, typename Symbol >
+bool TransitionsWithEpsilon< State, Symbol >::onDomain( const Key& x ) const {
+    if( x.second.template is< Epsilon >() )
+        return epsilons.count( x.first ) > 0;
+    return symbols.count({ x.first, x.second.template getAs<Symbol>() }) > 0;
+}
+
+// Inserção/remoção
+template< typename State, typename Symbol >
+void TransitionsWithEpsilon< State, Symbol >::insert( const Key& x,
+        const std::set<State>& fx )
+{
+    if( x.second.template is< Epsilon >() )
+        epsilons[x.first].assign( fx.begin(), fx.end() );
+    else
+        symbols[{ x.first, x.second.template getAs<Symbol>() }] = fx;
+}
+
+template< typename State, typename Symbol >
+void TransitionsWithEpsilon< State, Symbol >::erase( const Key& x ) {
+    if( x.second.template is< Epsilon >() )
+        epsilons.erase( x.first );
+    else
+        symbols.erase({ x.first, x.second.template getAs<Symbol>() });
+}
+
+template< typename State, typename Symbol >
+void TransitionsWithEpsilon< State, Symbol >::add( const State& from,
+        const Either<Symbol, Epsilon>& s, const State& to )
+{
+    if( !s.template is< Epsilon >() ) {
+        symbols[{ from, s.template getAs<Symbol>() }].insert( to );
+        return;
+    }
+    std::vector< State >& successors = epsilons[from];
+    auto it = std::lower_bound( successors.begin(), successors.end(), to );
+    if( it == successors.end() || to < *it )
+        successors.insert( it, to );
+}
+
+// Acesso direto
+template< typename State, typename Symbol >
+auto TransitionsWithEpsilon< State, Symbol >::symbolTransitions() const
+    -> const SymbolTransitions&
+{
+    return symbols;
+}
+
+template< typename State, typename Symbol >
+auto TransitionsWithEpsilon< State, Symbol >::epsilonTransitions() const
+    -> const EpsilonTransitions&
+{
+    return epsilons;
+}
+
+template< typename State, typename Symbol >
+const std::vector< State >&
+TransitionsWithEpsilon< State, Symbol >::epsilonSuccessors(
+        const State& q ) const
+{
+    static const std::vector< State > none;
+    auto it = epsilons.find( q );
+    return it == epsilons.end() ? none : it->second;
+}
+
+// Iteradores
+template< typename State, typename Symbol >
+auto TransitionsWithEpsilon< State, Symbol >::begin() const -> const_iterator {
+    return const_iterator( symbols.begin(), symbols.end(), epsilons.begin() );
+}
+
+template< typename State, typename Symbol >
+auto TransitionsWithEpsilon< State, Symbol >::end() const -> const_iterator {
+    return const_iterator( symbols.end(), symbols.end(), epsilons.end() );
+}
+
+template< typename State, typename Symbol >
+TransitionsWithEpsilon< State, Symbol >::const_iterator::const_iterator(
+        typename SymbolTransitions::const_iterator symbol,
+        typename SymbolTransitions::const_iterator symbolEnd,
+        typename EpsilonTransitions::const_iterator epsilonIterator ) :
+    symbol( symbol ),
+    symbolEnd( symbolEnd ),
+    epsilonIterator( epsilonIterator )
+{}
+
+template< typename State, typename Symbol >
+auto TransitionsWithEpsilon< State, Symbol >::const_iterator::operator*() const
+    -> value_type
+{
+    if( symbol != symbolEnd )
+        return { {symbol->first.first, symbol->first.second}, symbol->second };
+    return { {epsilonIterator->first, epsilon},
+             std::set< State >( epsilonIterator->second.begin(),
+                                epsilonIterator->second.end() ) };
+}
+
+template< typename State, typename Symbol >
+auto TransitionsWithEpsilon< State, Symbol >::const_iterator::operator++()
+    -> const_iterator&
+{
+    if( symbol != symbolEnd )
+        ++symbol;
+    else
+        ++epsilonIterator;
+    return *this;
+}
+
+template< typename State, typename Symbol >
+auto TransitionsWithEpsilon< State, Symbol >::const_iterator::operator++( int )
+    -> const_iterator
+{
+    const_iterator copy = *this;
+    ++*this;
+    return copy;
+}
+
+template< typename State, typename Symbol >
+bool TransitionsWithEpsilon< State, Symbol >::const_iterator::operator==(
+        const const_iterator& other ) const
+{
+    return symbol == other.symbol && epsilonIterator == other.epsilonIterator;
+}
+
+template< typename State, typename Symbol >
+bool TransitionsWithEpsilon< State, Symbol >::const_iterator::operator!=(
+        const const_iterator& other ) const
+{
+    return !operator==( other );
+}
+
+#endif // TRANSITIONS_WITH_EPSILON_H
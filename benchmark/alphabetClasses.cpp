@@ -0,0 +1,78 @@
+/* alphabetClasses.cpp
+ * Compara DenseDFA (uma coluna por byte) com ByteClassDFA (uma coluna
+ * por classe de bytes) num autômato grande, e mede a minimização de
+ * um autômato com alfabeto largo, antes e depois da compressão.
+ */
+#include <cstdio>
+#include <string>
+#include "conversion.h"
+#include "automaton/alphabetClasses.h"
+#include "automaton/compaction.h"
+#include "automaton/dense.h"
+#include "automaton/minimization.h"
+#include "benchmark/lib/benchmark.h"
+#include "regex/parsing.h"
+#include "regex/thompson.h"
+
+int main() {
+    /* O DFA de (a|b)*a(a|b)^n possui 2^(n+1) estados; a tabela densa
+     * ocupa 2^(n+1) * 256 * 4 bytes, e não cabe na cache. */
+    std::string regex = "(a|b)*a";
+    for( int i = 0; i < 13; ++i )
+        regex += "(a|b)";
+
+    DFA< int, char > dfa = compact( minimize(
+                toCompactDFA( thompson( parse( regex ) ) ) ) );
+    DenseDFA< char > dense( dfa );
+    ByteClassDFA< char > classes( dfa );
+    std::printf( "Pattern (a|b)*a(a|b)^13, %zu states, %zu byte classes\n",
+            dfa.states.size(), classes.classes() );
+    std::printf( "Table sizes: %zu KB dense, %zu KB by class\n",
+            dense.size() * DenseDFA< char >::rowSize * 4 / 1024,
+            classes.size() * classes.classes() * 4 / 1024 );
+
+    std::string text = Benchmark::randomText( 1 << 24, "ab" );
+    bool r1 = false, r2 = false;
+    double t1 = Benchmark::measure( [&]() {
+        r1 = dense.accepts( text.begin(), text.end() );
+    }, 5 );
+    double t2 = Benchmark::measure( [&]() {
+        r2 = classes.accepts( text.begin(), text.end() );
+    }, 5 );
+    Benchmark::keep( r1 && r2 );
+    Benchmark::report( "DenseDFA::accepts", t1, text.size() );
+    Benchmark::report( "ByteClassDFA::accepts", t2, text.size() );
+
+    /* Num alfabeto de 52 letras, apenas a, b..z e A..Z se distinguem
+     * no autômato mínimo; as tabelas e os laços sobre o alfabeto do
+     * autômato comprimido têm 3 colunas em vez de 52. */
+    std::string wide = "(";
+    for( char c = 'a'; c <= 'z'; ++c )
+        wide = wide + c + "|" + char(c - 'a' + 'A') + "|";
+    wide.back() = ')';
+    std::string lower = "(a";
+    for( char c = 'b'; c <= 'z'; ++c )
+        lower = lower + "|" + c;
+    lower += ")";
+    std::string wideRegex = wide + "*a";
+    for( int i = 0; i < 8; ++i )
+        wideRegex += lower;
+
+    DFA< int, char > wideMin = compact( minimize(
+                toCompactDFA( thompson( parse( wideRegex ) ) ) ) );
+    SymbolClasses< char > wideClasses = symbolClasses( wideMin );
+    DFA< int, int > compressed = compressAlphabet( wideMin, wideClasses );
+    double t3 = Benchmark::measure( [&]() {
+        Benchmark::keep( minimize( wideMin ).states.size() );
+    } );
+    double t4 = Benchmark::measure( [&]() {
+        Benchmark::keep( minimize( compressed ).states.size() );
+    } );
+    std::printf( "\nWide alphabet: %zu states, %zu symbols, %zu classes\n",
+            wideMin.states.size(), wideMin.alphabet.size(),
+            wideClasses.size() );
+    std::printf( "%-32s %10.3f ms\n", "minimize", t3 * 1e3 );
+    std::printf( "%-32s %10.3f ms\n", "minimize, compressed alphabet",
+            t4 * 1e3 );
+    return r1 == r2 ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+/* bisimulation.cpp
+ * Compara a equivalência de NFAs por bisimulação a menos de congruência
+ * (automaton/bisimulation.h) com a determinização dos dois autômatos
+ * seguida de equivalent para DFAs.
+ *
+ * São usadas duas famílias clássicas:
+ *  - (a|b)*a(a|b)^n, cujo autômato de subconjuntos possui 2^(n+1)
+ *    estados, comparada com a mesma expressão escrita de outra forma
+ *    (equivalentes) ou com um (a|b) a mais (não equivalentes);
+ *  - as palavras de tamanho maior que n, escritas como a união
+ *    (a|b)*a(a|b)^n | (a|b)*b(a|b)^n, cujo autômato de subconjuntos
+ *    também é exponencial, comparadas com (a|b)^(n+1)(a|b)*
+ *    (equivalentes) ou com (a|b)^n(a|b)* (não equivalentes).
+ */
+#include <cstdio>
+#include <string>
+#include "conversion.h"
+#include "automaton/bisimulation.h"
+#include "automaton/decisionProcedures.h"
+#include "benchmark/lib/benchmark.h"
+#include "test/lib/automata.h"
+
+namespace {
+
+/* Compara os autômatos das expressões x e y; sameLanguage indica se
+ * eles deveriam ser equivalentes. */
+void run( const char * name, int n, const std::string& x,
+          const std::string& y, bool sameLanguage, bool determinize )
+{
+    NFAe< int, char > a = automaton( x );
+    NFAe< int, char > b = automaton( y );
+
+    bool r1 = false, r2 = false;
+    double hkc = Benchmark::measure( [&]() { r1 = equivalent( a, b ); } );
+    std::printf( "%-8s n = %2d, %-14s HKC %10.3f ms", name, n,
+            sameLanguage ? "equivalent" : "not equivalent", hkc * 1e3 );
+    if( determinize ) {
+        double dfa = Benchmark::measure( [&]() {
+            r2 = equivalent( toDFA( a ), toDFA( b ) );
+        } );
+        std::printf( "   toDFA + equivalent %10.3f ms", dfa * 1e3 );
+        if( r1 != r2 )
+            std::printf( "   (MISMATCH)" );
+    }
+    if( r1 != sameLanguage )
+        std::printf( "   (WRONG)" );
+    std::printf( "\n" );
+    Benchmark::keep( r1 || r2 );
+}
+
+// (a|b)*a(a|b)^n
+void nthFromEnd( int n, bool determinize ) {
+    std::string x = family( "(a|b)*a", "(a|b)", n );
+    run( "a at -n", n, x, family( "(b|a)*a", "(b|a)", n ), true, determinize );
+    run( "a at -n", n, x, family( "(b|a)*a", "(b|a)", n + 1 ), false,
+         determinize );
+}
+
+// Palavras de tamanho maior que n.
+void longerThan( int n, bool determinize ) {
+    std::string x = family( "(a|b)*a", "(a|b)", n ) + "|" +
+                    family( "(a|b)*b", "(a|b)", n );
+    run( "length", n, x, family( "", "(a|b)", n + 1 ) + "(a|b)*", true,
+         determinize );
+    run( "length", n, x, family( "", "(a|b)", n ) + "(a|b)*", false,
+         determinize );
+}
+
+} // anonymous namespace
+
+int main() {
+    for( int n : { 4, 6, 8, 10, 12 } ) {
+        nthFromEnd( n, true );
+        longerThan( n, true );
+    }
+    // A determinização se torna inviável a partir daqui.
+    for( int n : { 16, 20, 24 } ) {
+        nthFromEnd( n, false );
+        longerThan( n, false );
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+/* bitParallel.cpp
+ * Compara o caminho de De Simone (construção do DFA e execução com
+ * DFA::accepts e DenseDFA::accepts) com a simulação bit-paralela
+ * do autômato de Glushkov (BitParallelNFA).
+ */
+#include <cstdio>
+#include <string>
+#include "automaton/dense.h"
+#include "benchmark/lib/benchmark.h"
+#include "regex/bitParallel.h"
+#include "regex/deSimone.h"
+#include "regex/parsing.h"
+
+/* Mede a construção e a execução dos três reconhecedores para a
+ * expressão passada, sobre o texto passado. */
+template< std::size_t Words >
+bool compare( const std::string& regex, const std::string& text ) {
+    DFA< int, char > dfa;
+    double build1 = Benchmark::measure( [&]() {
+        dfa = deSimone( parse( regex ) );
+    } );
+    DenseDFA< char > dense( dfa );
+    BitParallelNFA< char, Words > * nfa = nullptr;
+    double build2 = Benchmark::measure( [&]() {
+        delete nfa;
+        nfa = new BitParallelNFA< char, Words >( parse( regex ) );
+    }, 10 );
+
+    std::printf( "\nPattern %s: %zu positions, %zu DFA states\n",
+            regex.c_str(), nfa->positions(), dfa.states.size() );
+    std::printf( "%-32s %10.3f ms\n", "deSimone construction", build1 * 1e3 );
+    std::printf( "%-32s %10.3f ms\n", "BitParallelNFA construction",
+            build2 * 1e3 );
+
+    bool r1 = false, r2 = false, r3 = false;
+    double map = Benchmark::measure( [&]() {
+        r1 = dfa.accepts( text.begin(), text.end() );
+    } );
+    double table = Benchmark::measure( [&]() {
+        r2 = dense.accepts( text.begin(), text.end() );
+    }, 20 );
+    double bits = Benchmark::measure( [&]() {
+        r3 = nfa->accepts( text.begin(), text.end() );
+    }, 5 );
+    Benchmark::keep( r1 && r2 && r3 );
+    delete nfa;
+
+    Benchmark::report( "DFA::accepts", map, text.size() );
+    Benchmark::report( "DenseDFA::accepts", table, text.size() );
+    Benchmark::report( "BitParallelNFA::accepts", bits, text.size() );
+    return r1 == r2 && r2 == r3;
+}
+
+int main() {
+    std::string text = "abb" + Benchmark::randomText( 1 << 22, "abc" );
+    std::string ab = "ab" + Benchmark::randomText( 1 << 22, "ab" );
+
+    /* O DFA de (a|b)*a(a|b)^n possui 2^(n+1) estados; o autômato de
+     * Glushkov possui apenas 2n + 3 posições. */
+    std::string exponential = "(a|b)*a";
+    for( int i = 0; i < 10; ++i )
+        exponential += "(a|b)";
+
+    bool ok = compare< 1 >( "(a|b)*abb(a|b|c)*", text );
+    ok &= compare< 1 >( exponential, ab );
+    ok &= compare< 2 >( "(abc|bca|cab|acb|bac|cba)*:(a|b|c)?"
+                        "(aa|bb|cc|abab|baba|caca)*", text );
+    return ok ? 0 : 1;
+}
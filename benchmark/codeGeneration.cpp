@@ -0,0 +1,50 @@
+/* codeGeneration.cpp
+ * Compara DFA::accepts e DenseDFA::accepts com a função gerada por
+ * tools/generate para a mesma expressão regular.
+ *
+ * Este programa inclui o cabeçalho benchmark/generated.h, gerado pelo
+ * alvo "codegen" do Makefile, que também define GENERATED_REGEX.
+ */
+#include <cstdio>
+#include <string>
+#include "conversion.h"
+#include "automaton/compaction.h"
+#include "automaton/dense.h"
+#include "automaton/minimization.h"
+#include "benchmark/generated.h"
+#include "benchmark/lib/benchmark.h"
+#include "regex/parsing.h"
+#include "regex/thompson.h"
+
+int main() {
+    std::string regex = GENERATED_REGEX;
+    DFA< int, char > dfa = compact( minimize( toCompactDFA(
+                thompson( parse( regex ) ) ) ) );
+    DenseDFA< char > dense( dfa );
+
+    /* O texto é aleatório, sobre o alfabeto da expressão. Para que a
+     * comparação seja justa, a expressão deve manter o autômato vivo
+     * durante toda a leitura, como a expressão padrão do Makefile. */
+    std::string alphabet( dfa.alphabet.begin(), dfa.alphabet.end() );
+    std::string text = Benchmark::randomText( 1 << 22, alphabet );
+    std::printf( "Pattern %s, %zu states, %zu bytes of input\n",
+            regex.c_str(), dfa.states.size(), text.size() );
+
+    bool r1 = false, r2 = false, r3 = false;
+    double map = Benchmark::measure( [&]() {
+        r1 = dfa.accepts( text.begin(), text.end() );
+    } );
+    double table = Benchmark::measure( [&]() {
+        r2 = dense.accepts( text.begin(), text.end() );
+    }, 20 );
+    double generated = Benchmark::measure( [&]() {
+        r3 = generatedMatcher( text.data(), text.data() + text.size() );
+    }, 20 );
+    Benchmark::keep( r1 && r2 && r3 );
+
+    Benchmark::report( "DFA::accepts", map, text.size() );
+    Benchmark::report( "DenseDFA::accepts", table, text.size() );
+    Benchmark::report( "generated matcher", generated, text.size() );
+    std::printf( "Speedup over DenseDFA: %.1fx\n", table / generated );
+    return r1 == r2 && r2 == r3 ? 0 : 1;
+}
@@ -0,0 +1,37 @@
+/* denseDFA.cpp
+ * Compara DFA::accepts (baseado em Math::Function) com DenseDFA::accepts.
+ */
+#include <cstdio>
+#include <string>
+#include "conversion.h"
+#include "automaton/compaction.h"
+#include "automaton/dense.h"
+#include "automaton/minimization.h"
+#include "benchmark/lib/benchmark.h"
+#include "regex/parsing.h"
+#include "regex/thompson.h"
+
+int main() {
+    std::string regex = "(a|b)*abb(a|b|c)*";
+    DFA< int, char > dfa = compact( minimize( compact(
+                toDFA( thompson( parse( regex ) ) ) ) ) );
+    DenseDFA< char > dense( dfa );
+
+    std::string text = "abb" + Benchmark::randomText( 1 << 22, "abc" );
+    std::printf( "Pattern %s, %zu states, %zu bytes of input\n",
+            regex.c_str(), dfa.states.size(), text.size() );
+
+    bool r1 = false, r2 = false;
+    double map = Benchmark::measure( [&]() {
+        r1 = dfa.accepts( text.begin(), text.end() );
+    } );
+    double table = Benchmark::measure( [&]() {
+        r2 = dense.accepts( text.begin(), text.end() );
+    }, 20 );
+    Benchmark::keep( r1 && r2 );
+
+    Benchmark::report( "DFA::accepts", map, text.size() );
+    Benchmark::report( "DenseDFA::accepts", table, text.size() );
+    std::printf( "Speedup: %.1fx\n", map / table );
+    return r1 == r2 ? 0 : 1;
+}
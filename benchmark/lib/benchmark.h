@@ -0,0 +1,63 @@
+/* benchmark.h
+ * Funções auxiliares para os programas de medição de desempenho
+ * do diretório benchmark/.
+ *
+ * Cada programa de benchmark é um executável independente, construído
+ * com otimizações (veja o alvo "benchmark" do Makefile); estes programas
+ * não fazem parte de a.out.
+ */
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace Benchmark {
+
+/* Executa f o número de vezes especificado e retorna o tempo médio,
+ * em segundos, de cada execução. */
+template< typename F >
+double measure( F f, unsigned repetitions = 1 ) {
+    auto start = std::chrono::steady_clock::now();
+    for( unsigned i = 0; i < repetitions; ++i )
+        f();
+    std::chrono::duration< double > elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / repetitions;
+}
+
+/* Imprime o tempo gasto para processar a quantidade de bytes passada,
+ * e a vazão resultante em MB/s. */
+inline void report( const char * name, double seconds, std::size_t bytes ) {
+    std::printf( "%-32s %10.3f ms %10.1f MB/s\n", name, seconds * 1e3,
+            bytes / seconds / 1e6 );
+}
+
+/* Gera uma cadeia de caracteres pseudo-aleatória de tamanho n,
+ * com caracteres escolhidos uniformemente em alphabet.
+ * A semente é fixa, para que as medições sejam reprodutíveis. */
+inline std::string randomText( std::size_t n, const std::string& alphabet,
+        unsigned seed = 42 )
+{
+    std::mt19937 generator( seed );
+    std::uniform_int_distribution< std::size_t > d( 0, alphabet.size() - 1 );
+    std::string s( n, ' ' );
+    for( char& c : s )
+        c = alphabet[d( generator )];
+    return s;
+}
+
+/* Impede que o compilador elimine o cálculo do valor passado. */
+template< typename T >
+void keep( const T& value ) {
+    static volatile bool sink;
+    sink = bool( value );
+    (void) sink;
+}
+
+} // namespace Benchmark
+
+#endif // BENCHMARK_H
@@ -0,0 +1,48 @@
+/* parallel.cpp
+ * Mede a escalabilidade de parallelAccepts em relação ao número de
+ * threads, comparando com a execução sequencial de DenseDFA::accepts.
+ */
+#include <cstdio>
+#include <string>
+#include <thread>
+#include "conversion.h"
+#include "automaton/compaction.h"
+#include "automaton/dense.h"
+#include "automaton/minimization.h"
+#include "automaton/parallel.h"
+#include "benchmark/lib/benchmark.h"
+#include "regex/parsing.h"
+#include "regex/thompson.h"
+
+int main() {
+    std::string regex = "(a|b)*abb(a|b|c)*";
+    DFA< int, char > dfa = compact( minimize( compact(
+                toDFA( thompson( parse( regex ) ) ) ) ) );
+    DenseDFA< char > dense( dfa );
+
+    std::string text = "abb" + Benchmark::randomText( 1 << 27, "abc" );
+    unsigned cores = std::thread::hardware_concurrency();
+    std::printf( "Pattern %s, %zu states, %zu bytes of input, %u cores\n",
+            regex.c_str(), dfa.states.size(), text.size(), cores );
+
+    bool expected = false, ok = true;
+    double sequential = Benchmark::measure( [&]() {
+        expected = dense.accepts( text.begin(), text.end() );
+    }, 3 );
+    Benchmark::report( "DenseDFA::accepts", sequential, text.size() );
+
+    for( unsigned threads : {1u, 2u, 4u, 8u, 16u} ) {
+        bool r = false;
+        double t = Benchmark::measure( [&]() {
+            r = parallelAccepts( dense, text.begin(), text.end(), threads );
+        }, 3 );
+        ok &= r == expected;
+
+        char name[64];
+        std::snprintf( name, sizeof name, "parallelAccepts, %u threads",
+                threads );
+        Benchmark::report( name, t, text.size() );
+        std::printf( "%-32s %10.2fx\n", "  speedup", sequential / t );
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,76 @@
+/* parsing.cpp
+ * Mede o parsing de expressões regulares: muitas regras curtas, como as
+ * de um analisador léxico, uma expressão longa e uma expressão com
+ * muitos parênteses aninhados.
+ *
+ * parse lê os tokens diretamente da expressão; o pipeline com vetores
+ * de tokens (tokenize, explicitConcatenations e buildExpressionTree)
+ * é medido para comparação.
+ */
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "benchmark/lib/benchmark.h"
+#include "regex/parsing.h"
+
+namespace {
+
+/* Gera regras pseudo-aleatórias no estilo de um analisador léxico:
+ * palavras-chave, classes de caracteres e repetições. */
+std::vector< std::string > rules( std::size_t n ) {
+    std::vector< std::string > v;
+    std::string words = Benchmark::randomText( 8 * n, "abcdefghij" );
+    for( std::size_t i = 0; i < n; ++i ) {
+        std::string w = words.substr( 8 * i, 2 + i % 6 );
+        switch( i % 4 ) {
+            case 0: v.push_back( w ); break;
+            case 1: v.push_back( "(" + w + "|" + w.substr( 1 ) + ")+" ); break;
+            case 2: v.push_back( w + "(0|1|2|3|4|5|6|7|8|9)*" ); break;
+            case 3: v.push_back( "(" + w + ")?\\." + w + ":," ); break;
+        }
+    }
+    return v;
+}
+
+template< typename F >
+void run( const char * name, const std::vector< std::string >& input,
+          F parser, unsigned repetitions )
+{
+    std::size_t bytes = 0, nodes = 0;
+    for( const std::string& s : input )
+        bytes += s.size();
+    double time = Benchmark::measure( [&]() {
+        for( const std::string& s : input )
+            nodes += parser( s ).raw().size();
+    }, repetitions );
+    Benchmark::keep( nodes );
+    Benchmark::report( name, time, bytes );
+}
+
+} // anonymous namespace
+
+int main() {
+    auto direct = []( const std::string& s ) { return parse( s ); };
+    auto tokens = []( const std::string& s ) {
+        return buildExpressionTree(
+                explicitConcatenations( tokenize( s.begin(), s.end() ) ) );
+    };
+
+    std::vector< std::string > many = rules( 50000 );
+    std::string longExpression;
+    for( std::size_t i = 0; i < 200000; ++i )
+        longExpression += "ab|c*"[i % 5];
+    std::size_t depth = 100000;
+    std::string deep = std::string( depth, '(' ) + "a" +
+                       std::string( depth, ')' ) + "*";
+
+    std::printf( "%zu rules, a %zu-byte expression and %zu nested "
+                 "parentheses\n", many.size(), longExpression.size(), depth );
+    run( "parse (50000 rules)", many, direct, 5 );
+    run( "token vectors (50000 rules)", many, tokens, 5 );
+    run( "parse (long expression)", { longExpression }, direct, 5 );
+    run( "token vectors (long expression)", { longExpression }, tokens, 5 );
+    run( "parse (nested parentheses)", { deep }, direct, 5 );
+    run( "token vectors (nested)", { deep }, tokens, 5 );
+    return 0;
+}
@@ -14,12 +14,18 @@
 #include <set>
 #include <map>
 #include <queue>
+#include <stdexcept>
+#include <unordered_map>
 #include <utility>
+#include <vector>
+#include "automaton/alphabetClasses.h"
 #include "automaton/deterministic.h"
+#include "automaton/epsilonClosure.h"
 #include "automaton/nonDeterministic.h"
 #include "automaton/nonDeterministicWithEpsilon.h"
 #include "automaton/newState.h"
 #include "grammar/grammar.h"
+#include "utility/bitset.h"
 
 /* Converte objetos para autômatos finitos determinísticos equivalentes.
  *
@@ -38,6 +44,24 @@ DFA< std::set<State>, Symbol >         toDFA( NFAe< State, Symbol > );
 template< typename NonTerminal, typename Terminal >
 DFA< std::set<NonTerminal>, Terminal > toDFA( Grammar<NonTerminal, Terminal> );
 
+/* Determinização de autômatos compactos (veja automaton/compaction.h).
+ *
+ * Equivalente a compact( toDFA( automaton ) ), mas os subconjuntos de
+ * estados são representados por mapas de bits (utility/bitset.h), e
+ * recebem um número assim que são descobertos. Assim, não são
+ * construídos conjuntos de conjuntos nem é necessário compactar o
+ * resultado.
+ *
+ * O autômato retornado é compacto; o estado 0 é o estado inicial.
+ *
+ * Os estados do autômato de entrada devem ser {0, 1, ..., n-1}, como
+ * no autômato retornado por thompson(); o estado inicial pode ser
+ * qualquer um deles. Caso contrário, std::domain_error é lançado. */
+template< typename Symbol >
+DFA< int, Symbol > toCompactDFA( const NFA< int, Symbol >& );
+template< typename Symbol >
+DFA< int, Symbol > toCompactDFA( const NFAe< int, Symbol >& );
+
 /* Converte representações de linguagens formais para autômatos
  * finitos não determinísticos, sem transições-épsilon.
  *
@@ -53,6 +77,14 @@ NFA< State, Symbol >         toNFA( NFAe< State, Symbol > );
 template< typename NonTerminal, typename Terminal >
 NFA< NonTerminal, Terminal > toNFA( Grammar< NonTerminal, Terminal > );
 
+/* Remoção de transições-épsilon usando uma tabela de fechos-épsilon
+ * já calculada (veja automaton/epsilonClosure.h), que pode ser
+ * reutilizada por várias conversões do mesmo autômato.
+ * toNFA( nfae ) constrói a tabela e chama esta função. */
+template< typename State, typename Symbol >
+NFA< State, Symbol > toNFA( const NFAe< State, Symbol >&,
+                            const EpsilonClosureTable< State >& );
+
 /* Converte representações de linguagens regulares para autômatos
  * finitos não deterministicos com transições-épsilon equivalentes.
  *
@@ -131,13 +163,15 @@ DFA< std::set<State>, Symbol > toDFA( NFA< State, Symbol > nfa ) {
     while( !statesToBeIncluded.empty() ) {
         set< State > current = statesToBeIncluded.front();
         statesToBeIncluded.pop();
+        /* O estado é incluído antes do laço, para que autômatos com
+         * alfabeto vazio também tenham o estado inicial. */
+        dfa.states.insert( current );
         for( Symbol a : nfa.alphabet ) {
             // Construiremos a transição de current com o símbolo a.
             set<State> next;
             for( State q : current )
                 unite( next, delta( q, a ) );
 
-            dfa.states.insert( current );
             dfa.delta.insert( {current, a}, next );
             markToInclusion( next );
         }
@@ -161,6 +195,88 @@ DFA< std::set<State>, Symbol > toDFA( NFAe< State, Symbol > nfae ) {
     return toDFA( toNFA( nfae ) );
 }
 
+// NFA compacto para DFA compacto
+template< typename Symbol >
+DFA< int, Symbol > toCompactDFA( const NFA< int, Symbol >& nfa ) {
+    std::size_t n = nfa.states.size();
+    if( n > 0 && ( *nfa.states.begin() != 0 ||
+                   *nfa.states.rbegin() != int(n - 1) ) )
+        throw std::domain_error( "Automaton is not compact." );
+
+    std::vector< Symbol > symbols( nfa.alphabet.begin(), nfa.alphabet.end() );
+    std::size_t k = symbols.size();
+    std::map< Symbol, int > symbolIndex;
+    for( std::size_t a = 0; a < k; ++a )
+        symbolIndex[symbols[a]] = a;
+
+    /* successors[q*k + a] é a lista de estados alcançados a partir de q
+     * por a; isto evita consultar nfa.delta durante a construção. */
+    std::vector< std::vector< int > > successors( n * k );
+    for( const auto& pair : nfa.delta )
+        if( symbolIndex.count( pair.first.second ) > 0 )
+            successors[pair.first.first * k + symbolIndex[pair.first.second]]
+                .assign( pair.second.begin(), pair.second.end() );
+
+    Bitset finalStates( n );
+    for( int q : nfa.finalStates )
+        finalStates.set( q );
+
+    DFA< int, Symbol > dfa;
+    dfa.alphabet = nfa.alphabet;
+    dfa.initialState = 0;
+
+    /* Cada subconjunto recebe o próximo número disponível quando é
+     * descoberto. subsets[i] aponta para a chave do subconjunto i
+     * dentro de ids; ponteiros para elementos de std::unordered_map
+     * permanecem válidos mesmo após inserções. */
+    std::unordered_map< Bitset, int, BitsetHash > ids;
+    std::vector< const Bitset * > subsets;
+    auto idOf = [&]( const Bitset& s ) {
+        auto pair = ids.insert({ s, (int) subsets.size() });
+        if( pair.second ) {
+            subsets.push_back( &pair.first->first );
+            dfa.states.insert( dfa.states.end(), pair.first->second );
+            if( s.intersects( finalStates ) )
+                dfa.finalStates.insert( pair.first->second );
+        }
+        return pair.first->second;
+    };
+
+    Bitset initial( n );
+    initial.set( nfa.initialState );
+    idOf( initial );
+
+    /* Símbolos equivalentes (veja automaton/alphabetClasses.h) levam
+     * cada subconjunto ao mesmo destino; o destino é calculado apenas
+     * para o representante de cada classe. */
+    SymbolClasses< Symbol > classes = symbolClasses( nfa );
+    std::vector< std::vector< Symbol > > members( classes.size() );
+    for( const auto& pair : classes.classOf )
+        members[pair.second].push_back( pair.first );
+
+    Bitset next( n );
+    for( std::size_t i = 0; i < subsets.size(); ++i )
+        for( std::size_t c = 0; c < classes.size(); ++c ) {
+            int a = symbolIndex[classes.representatives[c]];
+            next.clear();
+            subsets[i]->forEach( [&]( std::size_t q ) {
+                for( int r : successors[q * k + a] )
+                    next.set( r );
+            });
+            int target = idOf( next );
+            for( const Symbol& s : members[c] )
+                dfa.delta.insert( {(int) i, s}, target );
+        }
+
+    return dfa;
+}
+
+// NFAe compacto para DFA compacto
+template< typename Symbol >
+DFA< int, Symbol > toCompactDFA( const NFAe< int, Symbol >& nfae ) {
+    return toCompactDFA( toNFA( nfae ) );
+}
+
 // Gramática para DFA
 template< typename NonTerminal, typename Terminal >
 DFA<std::set<NonTerminal>, Terminal> toDFA( Grammar<NonTerminal, Terminal> g ) {
@@ -189,68 +305,61 @@ NFA< State, Symbol > toNFA( NFA< State, Symbol > nfa ) {
 // NFAe para NFA
 template< typename State, typename Symbol >
 NFA< State, Symbol > toNFA( NFAe< State, Symbol > nfae ) {
+    return toNFA( nfae, EpsilonClosureTable< State >( nfae ) );
+}
+
+template< typename State, typename Symbol >
+NFA< State, Symbol > toNFA( const NFAe< State, Symbol >& nfae,
+                            const EpsilonClosureTable< State >& closure )
+{
     using std::pair;
     using std::set;
     NFA< State, Symbol > nfa;
 
-    /* Une o segundo conjunto ao primeiro. */
-    auto setUnion = []( set<State>& base, const set<State>& target ) {
-        base.insert( target.begin(), target.end() );
-    };
-    /* epsilonClosureTo( q, a ) é a união de todos os delta( p, a ),
-     * para p pertencente a epsilonClosure( q ).
-     *
-     * Isto é, é o conjunto de estados que pode ser alcançado a partir
-     * de q, fazendo quantas transições-épsilon forem desejadas, e, por
-     * fim, uma transição por a. */
-    auto epsilonClosureTo = [&]( State q, Symbol a ) {
-        set< State > r;
-        for( State p : nfae.epsilonClosure( q ) )
-            if( nfae.delta.onDomain({p, a}) )
-                setUnion( r, nfae.delta({p, a}) );
-        return r;
-    };
-    /* epsilonClosureOfSet( s ) é a união dos fechamentos-épsilon
-     * dos estados do conjunto s. */
-    auto epsilonClosureOfSet = [&]( set<State> s ) {
-        set< State > r;
-        for( State q : s )
-            setUnion( r, nfae.epsilonClosure( q ) );
-        return r;
-    };
-    /* reachableStatesWith( q, a ) é a união dos fechos-épsilon
-     * dos conjuntos delta( p, a ) para p pertencente ao fecho-épsilon
-     * de q.
+    /* closedMove[(p, a)] é o fecho-épsilon de delta( p, a ).
      *
-     * Isto é, o conjunto dos conjuntos alcançáveis a partir de q,
-     * fazendo zero ou mais transições-épsilon, então uma transição
-     * por a, e então zero ou mais transições-épsilon. */
-    auto reachableStatesWith = [&]( State q, Symbol a ) {
-        return epsilonClosureOfSet( epsilonClosureTo( q, a ) );
-    };
-    // true se a interseção dos dois conjuntos for vazia.
-    auto emptyIntersection = []( set< State > a, set< State > b ) {
-        for( State q : a )
-            if( b.count( q ) > 0 )
-                return false;
-        return true;
-    };
+     * A nova transição de q por a é a união de closedMove[(p, a)],
+     * para p pertencente ao fecho-épsilon de q. Isto é, o conjunto
+     * de estados alcançável a partir de q fazendo zero ou mais
+     * transições-épsilon, então uma transição por a, e então zero ou
+     * mais transições-épsilon. */
+    std::map< pair<State, Symbol>, set<State> > closedMove;
+    for( const auto& pair : nfae.delta.symbolTransitions() )
+        closedMove[pair.first] = closure( pair.second );
 
     nfa.states = nfae.states;
     nfa.alphabet = nfae.alphabet;
 
-    for( State q : nfae.states )
+    /* Estados da mesma componente possuem o mesmo fecho-épsilon, e,
+     * portanto, as mesmas transições; cada linha é calculada apenas
+     * uma vez por componente. */
+    std::vector< std::vector< set<State> > > rows( closure.components() );
+    for( State q : nfae.states ) {
+        std::vector< set<State> >& row = rows[closure.component( q )];
+        if( row.empty() ) {
+            for( Symbol a : nfae.alphabet ) {
+                set< State > r;
+                for( State p : closure( q ) ) {
+                    auto it = closedMove.find({p, a});
+                    if( it != closedMove.end() )
+                        r.insert( it->second.begin(), it->second.end() );
+                }
+                row.push_back( r );
+            }
+        }
+        auto it = row.begin();
         for( Symbol a : nfae.alphabet )
-            nfa.delta.insert( {q, a}, reachableStatesWith( q, a ) );
+            nfa.delta.insert( {q, a}, *it++ );
+    }
 
     nfa.initialState = nfae.initialState;
 
     nfa.finalStates = nfae.finalStates;
-    if( !emptyIntersection( 
-                nfae.finalStates, 
-                nfae.epsilonClosure( nfae.initialState )
-                ) )
-        nfa.finalStates.insert( nfa.initialState );
+    for( State q : closure( nfae.initialState ) )
+        if( nfae.finalStates.count( q ) > 0 ) {
+            nfa.finalStates.insert( nfa.initialState );
+            break;
+        }
 
     return nfa;
 }
@@ -7,6 +7,7 @@
 #ifndef EXCEPTIONS_H
 #define EXCEPTIONS_H
 
+#include <cstddef>
 #include <stdexcept>
 
 /* Exceção que deve ser lançada pelos algoritmos ao encontrar probelmas 
@@ -57,4 +58,24 @@ struct invalid_left_hand_side : public syntax_error {
         index( index )
     {}
 };
+
+/* Exceção lançada pelos analisadores léxicos caso nenhuma regra
+ * reconheça o restante da entrada.
+ *
+ * index é a posição da entrada em que o erro foi encontrado. */
+struct lexical_error : public std::runtime_error {
+    std::size_t index;
+    explicit lexical_error( const char * what, std::size_t index ) :
+        runtime_error( what ),
+        index( index )
+    {}
+};
+
+/* Exceção lançada ao ler um autômato serializado inválido: formato ou
+ * versão desconhecidos, tamanho inconsistente ou checksum incorreto. */
+struct serialization_error : public std::runtime_error {
+    explicit serialization_error( const char * what ) :
+        runtime_error( what )
+    {}
+};
 #endif // EXCEPTIONS_H
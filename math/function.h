@@ -13,9 +13,11 @@
 #define FUNCTION_H
 
 #include <exception>
+#include <stdexcept>
 #include <initializer_list>
 #include <map>
 #include <set>
+#include <type_traits>
 #include <utility> // std::pair
 
 namespace Math {
@@ -43,8 +45,15 @@ public:
      * em cada elemento do conjunto de entrada.
      *
      * Caso algum dos elementos esteja fora do domínio da função,
-     * std::domain_error é lançado. */
-    std::set< I > operator()( const std::set< D >& ) const;
+     * std::domain_error é lançado.
+     *
+     * Esta sobrecarga é um template para que listas entre chaves, como
+     * f({q, a}), sempre escolham a sobrecarga anterior: se D for
+     * std::pair<int, int>, {q, a} também construiria um std::set<D>
+     * (pelo construtor de intervalo), e a chamada seria ambígua. */
+    template< typename Set >
+    auto operator()( const Set& ) const -> typename std::enable_if<
+        std::is_same< Set, std::set< D > >::value, std::set< I > >::type;
 
     /* Retorna true caso x pertença ao domínio desta função.
      * operator() lança exceções exatamente quando onDomain() retorna false. */
@@ -86,7 +95,11 @@ I Function<D, I>::operator()( D x ) const {
 }
 
 template< typename D, typename I >
-std::set<I> Function<D, I>::operator()( const std::set<D>& s ) const {
+template< typename Set >
+auto Function<D, I>::operator()( const Set& s ) const -> typename
+    std::enable_if< std::is_same< Set, std::set< D > >::value,
+                    std::set< I > >::type
+{
     std::set<I> r; // [r]eturn
     for( const D& x : s )
         r.insert( operator()( x ) );
@@ -227,28 +227,28 @@ void print( const BinaryTree<EitherCEO>& tree ) {
     print( std::vector<TreeIterator>{ tree.root() } );
 }
 
-void print( const std::set< EitherIterator >& set ) {
+/* Imprime as posições do conjunto, como pares (posição, símbolo);
+ * a posição nula (o fim da expressão) é impressa como (null). */
+static void print( const Bitset& set, const Composition< char >& c ) {
     const char * str = "";
-    for( auto iterator : set ) {
-        if( iterator )
-            printf( "%s(%d,%s)", str, iterator.rawIndex(), tostr(*iterator) );
+    set.forEach( [&]( std::size_t p ) {
+        if( p < c.symbols.size() )
+            printf( "%s(%d,%s)", str, (int) p,
+                    tostr( Either<char, Epsilon, Operator>( c.symbols[p] ) ) );
         else
             printf( "%s(null)", str );
         str = " ";
-    }
+    });
 }
 
-void print( const std::pair<
-                std::set< EitherIterator >,
-                std::map< EitherIterator, std::set< EitherIterator > >
-            > & pair )
-{
+void print( const Composition< char >& composition ) {
     printf( "Initial: " );
-    print( pair.first );
+    print( composition.initial, composition );
     printf( "\n" );
-    for( auto inner : pair.second ) {
-        printf( "[%s, ", tostr( *inner.first ) );
-        print( inner.second );
+    for( std::size_t p = 0; p < composition.symbols.size(); ++p ) {
+        printf( "[%s, ", tostr( Either<char, Epsilon, Operator>(
+                    composition.symbols[p] ) ) );
+        print( composition.follow[p], composition );
         printf( "]\n" );
     }
 }
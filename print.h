@@ -13,11 +13,11 @@
 #include "automaton/nonDeterministic.h"
 #include "automaton/nonDeterministicWithEpsilon.h"
 #include "grammar/grammar.h"
+#include "regex/deSimone.h"
 #include "regex/tokens.h"
 #include "utility/binaryTree.h"
 #include "utility/either.h"
 
-typedef BinaryTree<Either<char, Epsilon, Operator>>::iterator EitherIterator;
 
 void print( const DFA< int, char >& );
 void print( const DFA< std::set<int>, char >& );
@@ -29,11 +29,7 @@ void print( const Grammar< int, char >& );
 void print( const Grammar< std::string, std::string >& );
 void print( const TokenVector< char >& );
 void print( const BinaryTree<Either<char, Epsilon, Operator>>& );
-void print( const std::set< EitherIterator >& );
-void print( const std::pair<
-                std::set< EitherIterator >,
-                std::map< EitherIterator, std::set< EitherIterator > >
-            > & );
+void print( const Composition< char >& );
                     
 
 /* Converte para string o objeto passado.
@@ -0,0 +1,191 @@
+/* bitParallel.h
+ * Simulação bit-paralela do autômato de Glushkov de uma expressão
+ * regular, construído a partir das composições de De Simone.
+ *
+ * As composições calculadas por buildComposition (regex/deSimone.h)
+ * são exatamente as posições e a relação de sucessão do autômato de
+ * Glushkov: cada folha da árvore é uma posição, a composição inicial
+ * é o conjunto das primeiras posições, a composição de uma folha é o
+ * conjunto das posições que podem segui-la, e o nó nulo indica que a
+ * expressão pode terminar ali.
+ *
+ * Em vez de determinizar o autômato, BitParallelNFA guarda o conjunto
+ * de posições ativas num vetor de bits e o atualiza, a cada símbolo
+ * lido, com algumas operações sobre palavras de 64 bits:
+ *     D' = Follow( D ) & B[c]
+ * em que B[c] é a máscara das posições rotuladas por c e Follow( D ) é
+ * a união das composições das posições de D. No algoritmo Shift-And,
+ * para expressões sem união nem fechamentos, Follow( D ) é D << 1; no
+ * caso geral, Follow( D ) é obtido de tabelas indexadas pelos bytes de
+ * D (Navarro e Raffinot): a tabela do k-ésimo byte guarda, para cada
+ * valor deste byte, a união das composições das posições correspondentes.
+ *
+ * O parâmetro Words determina a quantidade de palavras de 64 bits de
+ * cada vetor; o autômato suporta até 64 * Words - 1 posições, pois o
+ * bit 0 representa o início da leitura.
+ *
+ * Apenas símbolos de um byte são suportados.
+ */
+#ifndef BIT_PARALLEL_H
+#define BIT_PARALLEL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "epsilon.h"
+#include "algorithm/trees.h"
+#include "regex/deSimone.h"
+#include "regex/tokens.h"
+#include "utility/binaryTree.h"
+#include "utility/either.h"
+
+template< typename Char, std::size_t Words = 1 >
+class BitParallelNFA {
+    static_assert( sizeof(Char) == 1,
+        "BitParallelNFA supports only byte-sized symbols" );
+    static_assert( Words > 0, "BitParallelNFA needs at least one word" );
+
+public:
+    /* Quantidade máxima de posições (folhas) da expressão regular. */
+    static constexpr std::size_t maxPositions = 64 * Words - 1;
+
+    /* Constrói o simulador para a expressão regular passada.
+     *
+     * Exceções lançadas:
+     *  token_error      - caso um operador não previsto seja encontrado;
+     *  std::length_error - caso a expressão possua mais do que
+     *                     maxPositions posições. */
+    explicit BitParallelNFA( BinaryTree< Either<Char, Epsilon, Operator> > );
+
+    /* Determina se a expressão regular reconhece a palavra delimitada
+     * pelo intervalo [begin, end). */
+    template< typename ForwardIterator >
+    bool accepts( ForwardIterator begin, ForwardIterator end ) const;
+
+    /* Quantidade de posições da expressão regular. */
+    std::size_t positions() const;
+
+private:
+    typedef std::array< std::uint64_t, Words > Mask;
+
+    std::size_t m; // Quantidade de posições
+    std::size_t chunks; // Quantidade de bytes usados em cada máscara
+    Mask symbolMask[256]; // B[c]
+    std::vector< Mask > follow; // follow[k * 256 + byte]
+    Mask finalMask; // Posições após as quais a expressão pode terminar
+
+    static void setBit( Mask&, std::size_t );
+};
+
+// Implementação
+
+template< typename Char, std::size_t Words >
+constexpr std::size_t BitParallelNFA< Char, Words >::maxPositions;
+
+template< typename Char, std::size_t Words >
+BitParallelNFA< Char, Words >::BitParallelNFA(
+        BinaryTree< Either<Char, Epsilon, Operator> > tree )
+{
+    Mask zero;
+    zero.fill( 0 );
+    for( Mask& mask : symbolMask )
+        mask = zero;
+    finalMask = zero;
+
+    /* As posições da composição são deslocadas em 1 nas máscaras: o
+     * bit 0 é o início da leitura, cujos sucessores são a composição
+     * inicial. */
+    Composition< Char > composition;
+    removeSigmaClosure( tree );
+    removeEpsilon( tree );
+    tree.compact();
+    if( *tree.root() == epsilon ) {
+        m = 0;
+        setBit( finalMask, 0 );
+    }
+    else {
+        addRightThreads( tree.root() );
+        composition = buildComposition( tree.root() );
+        m = composition.symbols.size();
+        if( m > maxPositions )
+            throw std::length_error( "Too many positions for BitParallelNFA." );
+        for( std::size_t p = 0; p < m; ++p )
+            setBit( symbolMask[(unsigned char) composition.symbols[p]], p + 1 );
+    }
+
+    std::vector< Mask > successors( m + 1, zero );
+    for( std::size_t i = 0; i <= m; ++i )
+        ( i == 0 ? composition.initial : composition.follow[i - 1] ).forEach(
+            [&]( std::size_t p ) {
+                if( p == m )
+                    setBit( finalMask, i );
+                else
+                    setBit( successors[i], p + 1 );
+            });
+
+    /* follow[k * 256 + b] é a união das composições das posições
+     * 8k + j, para cada bit j ligado em b. Cada tabela é preenchida
+     * incrementalmente: a entrada b é a entrada b sem o seu bit menos
+     * significativo, unida à composição correspondente a este bit. */
+    chunks = (m + 1 + 7) / 8;
+    follow.assign( chunks * 256, zero );
+    for( std::size_t k = 0; k < chunks; ++k )
+        for( unsigned b = 1; b < 256; ++b ) {
+            unsigned low = __builtin_ctz( b );
+            std::size_t i = 8 * k + low;
+            Mask& entry = follow[k * 256 + b];
+            entry = follow[k * 256 + (b & (b - 1))];
+            if( i <= m )
+                for( std::size_t w = 0; w < Words; ++w )
+                    entry[w] |= successors[i][w];
+        }
+}
+
+template< typename Char, std::size_t Words >
+template< typename ForwardIterator >
+bool BitParallelNFA< Char, Words >::accepts( ForwardIterator begin,
+        ForwardIterator end ) const
+{
+    Mask d;
+    d.fill( 0 );
+    d[0] = 1; // Início da leitura
+
+    const Mask * table = follow.data();
+    for( ; begin != end; ++begin ) {
+        Mask next;
+        next.fill( 0 );
+        for( std::size_t k = 0; k < chunks; ++k ) {
+            /* A entrada 0 de cada tabela é vazia; não é necessário
+             * testar se o byte é nulo. */
+            unsigned b = (d[k / 8] >> (8 * (k % 8))) & 0xFF;
+            for( std::size_t w = 0; w < Words; ++w )
+                next[w] |= table[k * 256 + b][w];
+        }
+
+        const Mask& mask = symbolMask[(unsigned char) *begin];
+        std::uint64_t any = 0;
+        for( std::size_t w = 0; w < Words; ++w )
+            any |= d[w] = next[w] & mask[w];
+        if( any == 0 )
+            return false;
+    }
+
+    for( std::size_t w = 0; w < Words; ++w )
+        if( d[w] & finalMask[w] )
+            return true;
+    return false;
+}
+
+template< typename Char, std::size_t Words >
+std::size_t BitParallelNFA< Char, Words >::positions() const {
+    return m;
+}
+
+template< typename Char, std::size_t Words >
+void BitParallelNFA< Char, Words >::setBit( Mask& mask, std::size_t i ) {
+    mask[i / 64] |= std::uint64_t(1) << (i % 64);
+}
+
+#endif // BIT_PARALLEL_H
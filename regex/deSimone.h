@@ -5,16 +5,17 @@
 #ifndef DE_SIMONE_H
 #define DE_SIMONE_H
 
-#include <functional>
-#include <map>
+#include <algorithm>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 #include "epsilon.h"
 #include "exceptions.h"
 #include "algorithm/trees.h"
-#include "automaton/compaction.h"
 #include "automaton/deterministic.h"
 #include "regex/tokens.h"
 #include "utility/binaryTree.h"
+#include "utility/bitset.h"
 #include "utility/either.h"
 #include "utility/type_traits.h"
 
@@ -30,6 +31,17 @@ template< typename Char >
 DFA< int, Char > deSimone( BinaryTree< Either<Char, Epsilon, Operator> > );
 
 
+/* Composições das posições de uma expressão regular, calculadas por
+ * buildComposition. As posições são 0, 1, ..., n-1, em que n é
+ * symbols.size(), e o bit n de cada conjunto é o nó nulo (o fim da
+ * expressão). */
+template< typename Char >
+struct Composition {
+    std::vector< Char > symbols; // Símbolo de cada posição
+    Bitset initial; // Composição inicial
+    std::vector< Bitset > follow; // Composição de cada posição
+};
+
 /* O algoritmo de De Simone não é capaz de trabalhar com o operador libra
  * nem com épsilons na expressão regular. Estas duas funções removem
  * operadores libra, expandindo-os na definição do operador, e convertem
@@ -102,40 +114,25 @@ bool removeEpsilon( TreeIterator );
  * o 'a' e reconhecer um 'b'. Portanto, a composição inicial desta árvore
  * é {1, 2}.
  *
- * Por simplicidade, identificaremos os nós pelos iteradores que apontam
- * para eles.
- *
- * Esta função retorna um par de valores. O primeiro é a composição
- * inicial da árvore, e o segundo é um mapa que contém os pares
- * (nodo, composição), descrito acima. O nó nulo é representado pelo
- * iterador nulo.
+ * As folhas são numeradas, da esquerda para a direita, como as posições
+ * 0, 1, ..., n-1 da expressão; o nó nulo é representado pela posição n.
+ * Assim, cada composição é um Bitset de n+1 bits. Veja Composition.
  */
-template< typename TreeIterator >
-std::pair< std::set< TreeIterator >,
-           std::map< TreeIterator, std::set< TreeIterator > >
-         >
-buildComposition( TreeIterator root );
+template< typename TreeIterator,
+          typename Char = typename extract_head_type<
+                    typename TreeIterator::value_type
+                >::type >
+Composition< Char > buildComposition( TreeIterator root );
 
 /* Constrói o autômato finito a partir da composição inicial e da
- * composição de cada nodo folha.
+ * composição de cada posição.
  *
- * Note que o autômato retornado possui o conjunto de estados sobre
- * std::set< TreeIterator >, portanto é necessário compactá-lo. */
-template<
-        typename TreeIterator,
-        typename Char = typename extract_head_type<
-                            typename unqualified<
-                        decltype(*std::declval<TreeIterator>())
-                    >::type
-                >::type
-        >
-DFA< std::set< TreeIterator >, Char >
-buildAutomaton(
-        std::pair<
-            std::set< TreeIterator >,
-            std::map< TreeIterator, std::set< TreeIterator > >
-        >
-    );
+ * Cada estado do autômato é um conjunto de posições; os conjuntos são
+ * numerados na ordem em que são encontrados, numa busca em largura a
+ * partir da composição inicial (que é o estado 0), com os símbolos em
+ * ordem crescente. Portanto, o autômato retornado já é compacto. */
+template< typename Char >
+DFA< int, Char > buildAutomaton( const Composition< Char >& );
 
 
 // Implementação
@@ -143,6 +140,7 @@ template< typename Char >
 DFA< int, Char > deSimone( BinaryTree<Either<Char, Epsilon, Operator>> tree ) {
     removeSigmaClosure( tree );
     removeEpsilon( tree );
+    tree.compact();
     if( *tree.root() == epsilon )
         return { /* Q */     {0},
                  /* Sigma */ {},
@@ -151,13 +149,7 @@ DFA< int, Char > deSimone( BinaryTree<Either<Char, Epsilon, Operator>> tree ) {
                  /* F */     {0}
         };
     addRightThreads( tree.root() );
-    return compact(
-                buildAutomaton(
-                    buildComposition(
-                        tree.root()
-                    )
-                )
-           );
+    return buildAutomaton( buildComposition( tree.root() ) );
 }
 
 template< typename Char >
@@ -317,72 +309,98 @@ bool removeEpsilon( TreeIterator iterator ) {
     throw token_error( "Extraneous operator found" );
 }
 
-template< typename TreeIterator >
-std::pair< std::set< TreeIterator >,
-           std::map< TreeIterator, std::set< TreeIterator > >
-         >
-buildComposition( TreeIterator root ) {
-    using std::set;
-    typedef typename extract_head_type< 
-            typename unqualified< decltype(*root) >::type
-        >::type Char;
-
-    /* nodeList contém a lista de todos os nós da árvore acessíveis
-     * a partir do nodo raíz, e leafList contém apenas os nós folha. */
-    set< TreeIterator > nodeList;
-    set< TreeIterator > leafList;
-    std::function< void( TreeIterator ) > buildNodeList = 
-        [&]( TreeIterator iterator ) {
-            nodeList.insert( iterator );
-            if( iterator->template is<Operator>() )
-                switch( iterator->operator Operator() ) {
-                    case Operator::Concatenation:
-                    case Operator::VerticalBar:
-                        buildNodeList( iterator.rightChild() );
-                        // fall-through intencional
-                    case Operator::KleneeClosure:
-                    case Operator::PositiveClosure:
-                    case Operator::Optional:
-                        buildNodeList( iterator.leftChild() );
-                        break;
-                    default:
-                        throw token_error( "Unsupported operator" );
-                }
-            else if( iterator->template is<Char>() )
-                leafList.insert( iterator );
-        };
-
-    /* A navegação pela árvore será feita recursivamente e pode passar
-     * pelo mesmo nodo várias vezes. Para evitar recursão infinita,
-     * marcaremos neste mapa quais nodos já foram visitados.
-     *
-     * São feitas duas operações: aprofundar e avançar (ou descer e subir).
-     * Cada operação só pode ocorrer uma vez em cada elemento, mas podem
-     * ocorrer ambas as operações; portanto, precisamos de dois mapeamentos.
+template< typename TreeIterator, typename Char >
+Composition< Char > buildComposition( TreeIterator root ) {
+    /* Numeração dos nós acessíveis a partir da raiz, em pré-ordem, com
+     * os filhos da esquerda primeiro; assim, as folhas aparecem da
+     * esquerda para a direita. Apenas os filhos da direita dos
+     * operadores binários são filhos de fato; nos demais nós, o filho
+     * da direita é uma costura.
      *
-     * A função resetStatus (definida adiante) zera estes mapeamentos. */
-    std::map< TreeIterator, bool > deepened;
-    std::map< TreeIterator, bool > advanced;
-
-    auto resetStatus = [&]() {
-        for( TreeIterator iterator : nodeList )
-            deepened[iterator] = advanced[iterator] = false;
-        // Note que o mapeamento é construído na primeira execução.
+     * O nó nulo recebe o índice nodes.size(). */
+    std::vector< TreeIterator > nodes;
+    std::vector< TreeIterator > stack{ root };
+    while( !stack.empty() ) {
+        TreeIterator iterator = stack.back();
+        stack.pop_back();
+        nodes.push_back( iterator );
+        if( iterator->template is<Operator>() )
+            switch( iterator->operator Operator() ) {
+                case Operator::Concatenation:
+                case Operator::VerticalBar:
+                    stack.push_back( iterator.rightChild() );
+                    // fall-through intencional
+                case Operator::KleneeClosure:
+                case Operator::PositiveClosure:
+                case Operator::Optional:
+                    stack.push_back( iterator.leftChild() );
+                    break;
+                default:
+                    throw token_error( "Unsupported operator" );
+            }
+    }
+
+    const int null = nodes.size();
+    std::size_t maxIndex = 0;
+    for( TreeIterator iterator : nodes )
+        maxIndex = std::max< std::size_t >( maxIndex, iterator.rawIndex() );
+    std::vector< int > id( maxIndex + 1, -1 );
+    for( int i = 0; i < null; ++i )
+        id[nodes[i].rawIndex()] = i;
+    auto idOf = [&]( TreeIterator iterator ) {
+        return !iterator ? null : id[iterator.rawIndex()];
     };
 
-    /* Durante a navegação pela árvore, este conjunto armazenará
-     * a lista de iteradores que pertence à composição do nó analisado
-     * no momento. */
-    set< TreeIterator > current;
+    /* left e right são os índices dos filhos (ou da costura), op é o
+     * operador de cada nó interno e position é a posição de cada folha,
+     * ou -1. */
+    Composition< Char > composition;
+    std::vector< int > left( null, null ), right( null, null );
+    std::vector< int > position( null, -1 );
+    std::vector< Operator > op( null );
+    for( int i = 0; i < null; ++i ) {
+        right[i] = idOf( nodes[i].rightChild() );
+        if( nodes[i]->template is<Operator>() ) {
+            op[i] = nodes[i]->operator Operator();
+            left[i] = idOf( nodes[i].leftChild() );
+        }
+        else {
+            position[i] = composition.symbols.size();
+            composition.symbols.push_back( nodes[i]->template getAs<Char>() );
+        }
+    }
+    const int n = composition.symbols.size();
+
+    /* exit[i] é o nó alcançado ao terminar a subárvore do operador
+     * binário i: a costura do nó mais à direita da subárvore. Como os
+     * nós estão em pré-ordem, os filhos são processados antes. */
+    std::vector< int > exit( null, null );
+    for( int i = null - 1; i >= 0; --i )
+        if( position[i] == -1 && ( op[i] == Operator::Concatenation ||
+                                   op[i] == Operator::VerticalBar ) ) {
+            int r = right[i];
+            bool binary = position[r] == -1 &&
+                          ( op[r] == Operator::Concatenation ||
+                            op[r] == Operator::VerticalBar );
+            exit[i] = binary ? exit[r] : right[r];
+        }
 
-    std::function< void( TreeIterator ) > deepen; // "rotinas descer"
-    std::function< void( TreeIterator ) > advance; // "rotinas subir"
-    /* Estas duas funções mutuamente recursivas farão o trabalho pesado.
+    /* A navegação pela árvore pode passar pelo mesmo nodo várias vezes.
+     * São feitas duas operações: aprofundar e avançar (ou descer e
+     * subir). Cada operação só pode ocorrer uma vez em cada elemento,
+     * mas podem ocorrer ambas as operações; portanto, marcamos, para
+     * cada operação, a última rodada em que o nó foi visitado. Cada
+     * composição é calculada numa rodada diferente, e não é preciso
+     * zerar as marcas entre as rodadas. */
+    std::vector< int > deepened( null + 1, 0 ), advanced( null + 1, 0 );
+    int round = 0;
+
+    /* Estas duas operações farão o trabalho pesado.
      *
-     * deepen irá aprofundar a busca na árvore, buscando os nós que
-     * participarão das próximas transições. 
-     * advance tentará alcançar o próximo nodo, após já ter transitado
-     * pelos nodos da sub-árvore atual.
+     * Aprofundar (deepen) irá aprofundar a busca na árvore, buscando os
+     * nós que participarão das próximas transições.
+     * Avançar (advance) tentará alcançar o próximo nodo, após já ter
+     * transitado pelos nodos da sub-árvore atual.
      * Por exemplo:
      *          .                     .
      *         / \                   /4\
@@ -399,14 +417,14 @@ buildComposition( TreeIterator root ) {
      * Executar deepen no nodo 4 irá redirecionar a execução para o nodo 2,
      * tentando aprofundar. Por sua vez, deepen(2) se dividirá pelos nodos
      * 1 e 3, também aprofundando. Finalmente, deepen(1) adiciona o nodo
-     * 1 ao conjunto "current", e deepen(3) adiciona o 3.
+     * 1 ao conjunto atual, e deepen(3) adiciona o 3.
      *
      * advance é executado após a transição, para encontrar os "sucessores".
-     * advance(1) redireciona para advance(2), que redireciona para 
+     * advance(1) redireciona para advance(2), que redireciona para
      * advance(4). Como o nó 4 é uma concatenação, prosseguir para o próximo
      * nodo significa procurar as transições da subárvore da direita,
      * portanto, advance(4) redireciona para deepen(5).
-     * 
+     *
      * deepen também pode invocar advance:
      *      .
      *     /3\
@@ -418,228 +436,177 @@ buildComposition( TreeIterator root ) {
      * e advance(3) (pois o fechamento pode ser escolhido como épsilon,
      * avançando para a próxima subárvore).
      *
-     * Detalhes sobre o comportamento em cada operador é encontrado abaixo.
-     */
-    deepen = [&]( TreeIterator iterator ) {
-        if( deepened[iterator] ) return;
-        deepened[iterator] = true;
-        if( !iterator || iterator->template is<Char>() ) {
-            current.insert( iterator );
-            return;
-        }
-
-        switch( iterator->operator Operator() ) {
-            case Operator::KleneeClosure:
-                /*       * ->
-                 *     /
-                 * Podemos tanto descer na árvore 
-                 * quanto ir para o próximo nodo. 
-                 *
-                 * Como a árvore está costurada, o nó pai (que deve
-                 * ser o alvo do próximo advance) está, justamente,
-                 * no filho da direita deste nodo. */
-                deepen( iterator.leftChild() );
-                advance( iterator.rightChild() );
-                return;
-
-            case Operator::PositiveClosure:
-                /*       +
-                 *     /
-                 * Aqui somos obrigados a descer na árvore, pois o fecho
-                 * positivo reconhece ao menos uma vez a subárvore. */
-                deepen( iterator.leftChild() );
-                return;
-
-            case Operator::Optional:
-                /*       ? ->
-                 *     /
-                 */
-                deepen( iterator.leftChild() );
-                advance( iterator.rightChild() );
-                return;
-
-            case Operator::Concatenation:
-                /*      .
-                 *    / 
-                 */
-                deepen( iterator.leftChild() );
-                return;
-
-            case Operator::VerticalBar:
-                /*      |
-                 *    /   \
-                 */
-                deepen( iterator.leftChild() );
-                deepen( iterator.rightChild() );
-                return;
+     * Como a ordem das operações não altera o resultado, as operações
+     * pendentes ficam numa pilha explícita, em vez de chamadas
+     * recursivas. Como a árvore está costurada, o nó pai (que deve ser
+     * o alvo do próximo avanço) está, justamente, no filho da direita
+     * dos nós que não são operadores binários. */
+    enum Action { Deepen, Advance };
+    std::vector< std::pair< Action, int > > pending;
+    auto run = [&]( Bitset& current ) {
+        ++round;
+        while( !pending.empty() ) {
+            Action action = pending.back().first;
+            int i = pending.back().second;
+            pending.pop_back();
+
+            if( action == Deepen ) {
+                if( deepened[i] == round ) continue;
+                deepened[i] = round;
+                if( i == null || position[i] != -1 ) {
+                    current.set( i == null ? n : position[i] );
+                    continue;
+                }
+                switch( op[i] ) {
+                    case Operator::KleneeClosure:
+                    case Operator::Optional:
+                        /*       * ->        ? ->
+                         *     /           /
+                         * Podemos tanto descer na árvore
+                         * quanto ir para o próximo nodo. */
+                        pending.push_back({ Deepen, left[i] });
+                        pending.push_back({ Advance, right[i] });
+                        break;
+                    case Operator::PositiveClosure:
+                        /*       +
+                         *     /
+                         * Aqui somos obrigados a descer na árvore, pois
+                         * o fecho positivo reconhece ao menos uma vez a
+                         * subárvore. */
+                    case Operator::Concatenation:
+                        /*      .
+                         *    /
+                         */
+                        pending.push_back({ Deepen, left[i] });
+                        break;
+                    default: // Operator::VerticalBar
+                        /*      |
+                         *    /   \
+                         */
+                        pending.push_back({ Deepen, left[i] });
+                        pending.push_back({ Deepen, right[i] });
+                        break;
+                }
+                continue;
+            }
 
-            default:
-                /* Apenas para silenciar o warning.
-                 * Qualquer operador não suportado será detectado
-                 * em buildNodeList. */;
-        }
-    }; // fim deepen
-    advance = [&]( TreeIterator iterator ) {
-        if( advanced[iterator] ) return;
-        advanced[iterator] = true;
-        if( !iterator ) {
-            // Chegamos ao fim da árvore.
-            current.insert( nullptr );
-            return;
-        }
-        if( iterator->template is<Char>() ) {
-            advance( iterator.rightChild() );
-            return;
+            if( advanced[i] == round ) continue;
+            advanced[i] = round;
+            if( i == null ) {
+                // Chegamos ao fim da árvore.
+                current.set( n );
+                continue;
+            }
+            if( position[i] != -1 ) {
+                pending.push_back({ Advance, right[i] });
+                continue;
+            }
+            switch( op[i] ) {
+                case Operator::KleneeClosure:
+                case Operator::PositiveClosure:
+                    /*       * ->        + ->
+                     *     /           /
+                     * Podemos tanto descer na árvore (voltando) quanto
+                     * ir para o próximo nodo (avançando). No fecho
+                     * positivo, já passamos uma vez pela subárvore. */
+                    pending.push_back({ Deepen, left[i] });
+                    pending.push_back({ Advance, right[i] });
+                    break;
+                case Operator::Optional:
+                    /*       ? ->
+                     */
+                    pending.push_back({ Advance, right[i] });
+                    break;
+                case Operator::Concatenation:
+                    /*      .
+                     *        \
+                     */
+                    pending.push_back({ Deepen, right[i] });
+                    break;
+                default: // Operator::VerticalBar
+                    /*      | ->
+                     * Já escolhemos um dos lados; avançamos para depois
+                     * da subárvore inteira. */
+                    pending.push_back({ Advance, exit[i] });
+                    break;
+            }
         }
+    };
 
-        switch( iterator->operator Operator() ) {
-            case Operator::KleneeClosure:
-                /*       * ->
-                 *     /
-                 * Novamente podemos descer na árvore (voltando)
-                 * quanto ir para o próximo nodo (avançando). */
-                deepen( iterator.leftChild() );
-                advance( iterator.rightChild() );
-                return;
-
-            case Operator::PositiveClosure:
-                /*       + ->
-                 *     /
-                 * Já passamos uma vez por aqui, então podemos nos comportar
-                 * como Operator::KleneeClosure. */
-                deepen( iterator.leftChild() );
-                advance( iterator.rightChild() );
-                return;
-
-            case Operator::Optional:
-                /*       ? ->
-                 */
-                advance( iterator.rightChild() );
-                return;
-
-            case Operator::Concatenation:
-                /*      .
-                 *        \
-                 */
-                deepen( iterator.rightChild() );
-                return;
-
-            case Operator::VerticalBar:
-                /*      | ->
-                 * Para este operador precisaremos fazer um pouco de
-                 * malabarismo: desceremos pela subárvore à direita até
-                 * achar algum nó costurado e "subiremos" pela costura.
-                 */
-                do
-                    iterator = iterator.rightChild();
-                while( *iterator == Operator::Concatenation ||
-                       *iterator == Operator::VerticalBar );
-                advance( iterator.rightChild() );
-                return;
-
-            default:
-                ;
+    composition.follow.assign( n, Bitset( n + 1 ) );
+    for( int i = 0; i < null; ++i )
+        if( position[i] != -1 ) {
+            pending.push_back({ Advance, i });
+            run( composition.follow[position[i]] );
         }
-    }; // fim advance
-
-    std::map< TreeIterator, set< TreeIterator > > map;
-    buildNodeList( root );
-    nodeList.insert( nullptr );
-    resetStatus();
-    for( TreeIterator iterator : leafList ) {
-        advance( iterator );
-        map[iterator] = current;
-        current.clear();
-        resetStatus();
-    }
-    deepen( root ); // Obter a composição inicial
-    return {current, map};
+    composition.initial = Bitset( n + 1 );
+    pending.push_back({ Deepen, 0 }); // Obter a composição inicial
+    run( composition.initial );
+    return composition;
 }
 
-
-template< typename TreeIterator, typename Char >
-DFA< std::set< TreeIterator >, Char >
-buildAutomaton(
-        std::pair<
-            std::set< TreeIterator >,
-            std::map< TreeIterator, std::set< TreeIterator > >
-        > pair
-    )
-{
-    // Conveniência
-    typedef std::set< TreeIterator > State;
-    std::map< TreeIterator, State > & map = pair.second;
-    DFA< State, Char > dfa;
-
-    /* Estas duas funções controlam quais estados já foram processados.
-     * Como precisamos processar cada estado apenas uma vez, usaremos
-     * um std::set como fila. */
-    std::set< State > queue;
-    auto enqueue = [&]( State q ) {
-        if( dfa.states.count( q ) == 0 )
-            queue.insert( q );
-    };
-    auto dequeue = [&]() -> State {
-        State q = *queue.begin();
-        queue.erase( queue.begin() );
-        return q;
-    };
-
-    /* Adiciona na "fila" todos os estados alcançáveis a partir
-     * deste com apenas uma transição. */
-    auto enqueueDescendents = [&]( State q ) {
-        for( Char c : dfa.alphabet )
-            if( dfa.delta.onDomain({q, c}) )
-                enqueue( dfa.delta({q, c}) );
-    };
-
-    /* State é um conjunto, que representa a composição do estado.
-     * Esta função une o conjunto passado ao conjunto que é o
-     * alvo atual da transição. */
-    auto mergeTransition = [&]( State q, Char c, State r ) {
-        State s;
-        if( dfa.delta.onDomain({q, c}) )
-            s = dfa.delta({q, c});
-        s.insert( r.begin(), r.end() );
-        dfa.delta.insert( {q, c}, s );
-        dfa.alphabet.insert( c );
-    };
-
-    dfa.initialState = pair.first;
-    enqueue( pair.first );
+template< typename Char >
+DFA< int, Char > buildAutomaton( const Composition< Char >& composition ) {
+    const std::size_t n = composition.symbols.size();
+
+    /* Os símbolos são indexados em ordem crescente; symbol[p] é o
+     * índice do símbolo da posição p. */
+    DFA< int, Char > dfa;
+    dfa.alphabet.insert( composition.symbols.begin(),
+                         composition.symbols.end() );
+    std::vector< Char > alphabet( dfa.alphabet.begin(), dfa.alphabet.end() );
+    std::vector< int > symbol( n );
+    for( std::size_t p = 0; p < n; ++p )
+        symbol[p] = std::lower_bound( alphabet.begin(), alphabet.end(),
+                        composition.symbols[p] ) - alphabet.begin();
 
     /* A composição de um estado representa todas as possíveis próximas
-     * transições daquele estado. Começamos enfileirando o estado inicial.
-     *
-     * A cada passo, escolhemos um novo estado a ser adicionado.
-     * Devido ao controle de enqueue/dequeue, sabemos que este estado está
-     * sendo processado pela primeira vez.
-     * Ao transitar por um caractere do conjunto, temos de considerar todas
-     * as possíveis próximas transições por aquele caractere (porque a
-     * transição seguinte pode ser por qualquer uma delas). O estado de
-     * destino é a união das composições das transições por aquele caractere
-     * a partir daquele estado.
-     *
-     * Implementamos isso percorrendo todo o conjunto atual e unindo os
-     * conjuntos conforme os encontramos. Depois, basta percorrer todas
-     * as transições novamente e enfileirar os estados que acabaram de ser
-     * adicionados.
+     * transições daquele estado. Ao transitar por um caractere do
+     * conjunto, temos de considerar todas as possíveis próximas
+     * transições por aquele caractere (porque a transição seguinte pode
+     * ser por qualquer uma delas). O estado de destino é a união das
+     * composições das posições do estado rotuladas por aquele caractere.
      *
-     * Também temos de controlar os iteradores nulos: eles representam o
-     * fato de que o estado atual pode alcançar o fim da árvore.
-     * Portanto, inserimos o estado atual na lista de estados terminais. */
-    while( !queue.empty() ) {
-        State q = dequeue();
-        dfa.states.insert( q );
-        for( TreeIterator t : q )
-            if( t ) // t != null
-                mergeTransition( q, *t, map[t] );
-            else
-                dfa.finalStates.insert( q );
-
-        enqueueDescendents( q );
+     * A posição n representa o fato de que o estado atual pode alcançar
+     * o fim da árvore; portanto, o estado é terminal. */
+    std::unordered_map< Bitset, int, BitsetHash > ids;
+    std::vector< Bitset > subsets;
+    auto intern = [&]( const Bitset& s ) {
+        auto pair = ids.insert({ s, (int) subsets.size() });
+        if( pair.second )
+            subsets.push_back( s );
+        return pair.first->second;
+    };
+
+    std::vector< Bitset > targets( alphabet.size(), Bitset( n + 1 ) );
+    std::vector< int > touched; // Símbolos com transição a partir de q
+    std::vector< bool > marked( alphabet.size(), false );
+    dfa.initialState = intern( composition.initial );
+    for( std::size_t q = 0; q < subsets.size(); ++q ) {
+        subsets[q].forEach( [&]( std::size_t p ) {
+            if( p == n )
+                return;
+            if( !marked[symbol[p]] ) {
+                marked[symbol[p]] = true;
+                touched.push_back( symbol[p] );
+            }
+            targets[symbol[p]] |= composition.follow[p];
+        });
+        if( subsets[q].test( n ) )
+            dfa.finalStates.insert( q );
+
+        std::sort( touched.begin(), touched.end() );
+        for( int c : touched ) {
+            int r = intern( targets[c] ); // Pode realocar subsets.
+            dfa.delta.insert( {(int) q, alphabet[c]}, r );
+            targets[c].clear();
+            marked[c] = false;
+        }
+        touched.clear();
     }
 
+    for( std::size_t q = 0; q < subsets.size(); ++q )
+        dfa.states.insert( dfa.states.end(), q );
     return dfa;
 }
 #endif // DE_SIMONE_H
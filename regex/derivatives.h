@@ -0,0 +1,380 @@
+/* derivatives.h
+ * Conversão de expressões regulares em autômatos finitos determinísticos
+ * pelo método das derivadas de Brzozowski.
+ *
+ * A derivada de uma expressão r pelo símbolo a é a expressão que
+ * reconhece { w : aw pertence a L(r) }. Cada estado do autômato é uma
+ * expressão, o estado inicial é a própria expressão, a transição de r
+ * por a leva à derivada de r por a e os estados finais são as
+ * expressões que reconhecem a palavra vazia.
+ *
+ * Para que a quantidade de derivadas distintas seja finita, as
+ * expressões são mantidas simplificadas: a união é tratada como uma
+ * operação associativa, comutativa e idempotente (seus termos formam
+ * um conjunto ordenado, sem repetições e sem a linguagem vazia), a
+ * concatenação é associada à direita e absorve épsilon e a linguagem
+ * vazia, e (r*)* = r*. Além disso, as expressões são compartilhadas
+ * (hash-consing): cada expressão distinta é criada uma única vez e
+ * identificada por um inteiro, de modo que comparar duas expressões
+ * custa O(1).
+ *
+ * O autômato pode ser construído por inteiro (toDFA) ou sob demanda,
+ * durante a leitura de uma palavra (accepts): as derivadas já
+ * calculadas ficam numa tabela, e apenas as alcançadas pela entrada
+ * são calculadas. Frequentemente, o autômato obtido é bem menor do que
+ * o obtido pela determinização do autômato de Thompson.
+ */
+#ifndef DERIVATIVES_H
+#define DERIVATIVES_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "epsilon.h"
+#include "exceptions.h"
+#include "automaton/deterministic.h"
+#include "regex/tokens.h"
+#include "utility/binaryTree.h"
+#include "utility/either.h"
+
+template< typename Char >
+class DerivativeAutomaton {
+public:
+    /* Constrói o autômato, inicialmente apenas com o estado inicial.
+     *
+     * Exceção lançada:
+     *  token_error - caso algum operador não reconhecido esteja na árvore. */
+    explicit DerivativeAutomaton(
+            const BinaryTree< Either<Char, Epsilon, Operator> >& );
+
+    /* Determina se a expressão reconhece a palavra delimitada pelo
+     * intervalo [begin, end), calculando apenas as derivadas necessárias.
+     *
+     * Este método não é constante, pois altera a tabela de derivadas. */
+    template< typename ForwardIterator >
+    bool accepts( ForwardIterator begin, ForwardIterator end );
+
+    /* Calcula todas as derivadas alcançáveis a partir da expressão e
+     * retorna o autômato correspondente. Os estados são numerados na
+     * ordem em que são encontrados, numa busca em largura a partir do
+     * estado inicial (0); a derivada vazia, que não alcança estados
+     * finais, não é incluída. */
+    DFA< int, Char > toDFA();
+
+    /* Quantidade de expressões distintas criadas até o momento,
+     * incluindo as subexpressões. */
+    std::size_t expressions() const;
+
+private:
+    enum class Kind { Empty, Epsilon, Symbol, Concatenation, Union, Star };
+
+    /* Expressão simplificada. Na concatenação, os filhos são os dois
+     * operandos; na união, os termos, em ordem crescente; no fecho,
+     * o operando. */
+    struct Expression {
+        Kind kind;
+        Char symbol;
+        std::vector< int > children;
+        bool nullable; // A expressão reconhece a palavra vazia
+    };
+
+    struct ExpressionHash {
+        std::size_t operator()( const Expression& e ) const {
+            std::size_t h = std::size_t( e.kind ) * 1099511628211ull ^
+                            std::hash< Char >()( e.symbol );
+            for( int c : e.children )
+                h = ( h ^ std::size_t( c ) ) * 1099511628211ull;
+            return h;
+        }
+    };
+
+    struct ExpressionEqual {
+        bool operator()( const Expression& a, const Expression& b ) const {
+            return a.kind == b.kind && a.symbol == b.symbol &&
+                   a.children == b.children;
+        }
+    };
+
+    static constexpr int empty = 0; // Expressão que não reconhece nada
+    static constexpr int epsilonId = 1; // Expressão que reconhece épsilon
+    static constexpr int unknown = -1;
+
+    std::vector< Expression > expressionList;
+    std::unordered_map< Expression, int, ExpressionHash, ExpressionEqual > ids;
+    std::vector< Char > alphabet; // Em ordem crescente
+    std::vector< std::vector< int > > derivative; // [r][a], ou unknown
+    int root;
+
+    /* Retorna o identificador da expressão, criando-a se necessário. */
+    int intern( Kind, Char, std::vector< int > );
+
+    /* Construtores das expressões, já simplificadas. */
+    int symbol( Char );
+    int concatenate( int, int );
+    int unite( int, int );
+    int star( int );
+
+    /* Converte a subárvore cuja raiz é o nó passado. */
+    template< typename TreeIterator >
+    int build( TreeIterator );
+
+    /* Retorna a derivada de r pelo a-ésimo símbolo do alfabeto. */
+    int derive( int r, std::size_t a );
+
+    /* Índice do símbolo no alfabeto, ou -1. */
+    int indexOf( Char ) const;
+};
+
+/* Constrói o autômato das derivadas da expressão passada; equivale a
+ * DerivativeAutomaton< Char >( tree ).toDFA().
+ *
+ * Exceção lançada:
+ *  token_error - caso algum operador não reconhecido esteja na árvore. */
+template< typename Char >
+DFA< int, Char > brzozowski(
+        const BinaryTree< Either<Char, Epsilon, Operator> >& );
+
+// Implementação
+
+template< typename Char >
+constexpr int DerivativeAutomaton< Char >::empty;
+template< typename Char >
+constexpr int DerivativeAutomaton< Char >::epsilonId;
+template< typename Char >
+constexpr int DerivativeAutomaton< Char >::unknown;
+
+template< typename Char >
+DerivativeAutomaton< Char >::DerivativeAutomaton(
+        const BinaryTree< Either<Char, Epsilon, Operator> >& tree )
+{
+    intern( Kind::Empty, Char(), {} );
+    intern( Kind::Epsilon, Char(), {} );
+    root = build( tree.root() );
+
+    for( const Expression& e : expressionList )
+        if( e.kind == Kind::Symbol )
+            alphabet.push_back( e.symbol );
+    std::sort( alphabet.begin(), alphabet.end() );
+}
+
+template< typename Char >
+int DerivativeAutomaton< Char >::intern( Kind kind, Char c,
+                                         std::vector< int > children )
+{
+    Expression e{ kind, c, std::move( children ), false };
+    auto it = ids.find( e );
+    if( it != ids.end() )
+        return it->second;
+
+    switch( kind ) {
+        case Kind::Empty:
+        case Kind::Symbol:
+            e.nullable = false;
+            break;
+        case Kind::Epsilon:
+        case Kind::Star:
+            e.nullable = true;
+            break;
+        case Kind::Concatenation:
+            e.nullable = expressionList[e.children[0]].nullable &&
+                         expressionList[e.children[1]].nullable;
+            break;
+        case Kind::Union:
+            for( int t : e.children )
+                e.nullable = e.nullable || expressionList[t].nullable;
+            break;
+    }
+    int id = expressionList.size();
+    expressionList.push_back( e );
+    ids.insert({ e, id });
+    return id;
+}
+
+template< typename Char >
+int DerivativeAutomaton< Char >::symbol( Char c ) {
+    return intern( Kind::Symbol, c, {} );
+}
+
+template< typename Char >
+int DerivativeAutomaton< Char >::concatenate( int r, int s ) {
+    if( r == empty || s == empty )
+        return empty;
+    if( r == epsilonId )
+        return s;
+    if( s == epsilonId )
+        return r;
+    /* (r1 r2) s = r1 (r2 s); copiamos os filhos, pois intern pode
+     * realocar expressionList. */
+    if( expressionList[r].kind == Kind::Concatenation ) {
+        std::vector< int > children = expressionList[r].children;
+        return concatenate( children[0], concatenate( children[1], s ) );
+    }
+    return intern( Kind::Concatenation, Char(), {r, s} );
+}
+
+template< typename Char >
+int DerivativeAutomaton< Char >::unite( int r, int s ) {
+    if( r == s || s == empty )
+        return r;
+    if( r == empty )
+        return s;
+
+    // Junta os termos das duas uniões, ordenados e sem repetições.
+    std::vector< int > terms;
+    for( int t : {r, s} )
+        if( expressionList[t].kind == Kind::Union )
+            terms.insert( terms.end(), expressionList[t].children.begin(),
+                                       expressionList[t].children.end() );
+        else
+            terms.push_back( t );
+    std::sort( terms.begin(), terms.end() );
+    terms.erase( std::unique( terms.begin(), terms.end() ), terms.end() );
+    if( terms.size() == 1 )
+        return terms[0];
+    return intern( Kind::Union, Char(), std::move( terms ) );
+}
+
+template< typename Char >
+int DerivativeAutomaton< Char >::star( int r ) {
+    if( r == empty || r == epsilonId )
+        return epsilonId;
+    if( expressionList[r].kind == Kind::Star )
+        return r;
+    return intern( Kind::Star, Char(), {r} );
+}
+
+template< typename Char >
+template< typename TreeIterator >
+int DerivativeAutomaton< Char >::build( TreeIterator t ) {
+    if( t->template is<Char>() )
+        return symbol( t->operator Char() );
+    if( t->template is<Epsilon>() )
+        return epsilonId;
+
+    int r = build( t.leftChild() );
+    switch( t->template getAs<Operator>() ) {
+        case Operator::KleneeClosure :
+            return star( r );
+        case Operator::PositiveClosure :
+            return concatenate( r, star( r ) );
+        case Operator::Optional :
+            return unite( r, epsilonId );
+        case Operator::SigmaClosure : // x:y = x(yx)*
+            return concatenate( r, star(
+                        concatenate( build( t.rightChild() ), r ) ) );
+        case Operator::Concatenation :
+            return concatenate( r, build( t.rightChild() ) );
+        case Operator::VerticalBar :
+            return unite( r, build( t.rightChild() ) );
+    };
+    throw token_error( "Extraneous operator found" );
+}
+
+template< typename Char >
+int DerivativeAutomaton< Char >::derive( int r, std::size_t a ) {
+    if( derivative.size() <= (std::size_t) r )
+        derivative.resize( expressionList.size() );
+    if( derivative[r].empty() )
+        derivative[r].assign( alphabet.size(), unknown );
+    if( derivative[r][a] != unknown )
+        return derivative[r][a];
+
+    /* As referências para expressionList não sobrevivem às chamadas
+     * que criam expressões; por isso, copiamos o que for preciso. */
+    Kind kind = expressionList[r].kind;
+    std::vector< int > children = expressionList[r].children;
+    int d = empty;
+    switch( kind ) {
+        case Kind::Empty:
+        case Kind::Epsilon:
+            break;
+        case Kind::Symbol:
+            if( expressionList[r].symbol == alphabet[a] )
+                d = epsilonId;
+            break;
+        case Kind::Concatenation: // d(rs) = d(r)s | d(s), se r é anulável
+            d = concatenate( derive( children[0], a ), children[1] );
+            if( expressionList[children[0]].nullable )
+                d = unite( d, derive( children[1], a ) );
+            break;
+        case Kind::Union:
+            for( int t : children )
+                d = unite( d, derive( t, a ) );
+            break;
+        case Kind::Star: // d(r*) = d(r) r*
+            d = concatenate( derive( children[0], a ), r );
+            break;
+    }
+    derivative[r][a] = d;
+    return d;
+}
+
+template< typename Char >
+int DerivativeAutomaton< Char >::indexOf( Char c ) const {
+    auto it = std::lower_bound( alphabet.begin(), alphabet.end(), c );
+    if( it == alphabet.end() || *it != c )
+        return -1;
+    return it - alphabet.begin();
+}
+
+template< typename Char >
+template< typename ForwardIterator >
+bool DerivativeAutomaton< Char >::accepts( ForwardIterator begin,
+                                           ForwardIterator end )
+{
+    int r = root;
+    for( ; begin != end; ++begin ) {
+        int a = indexOf( *begin );
+        if( a == -1 )
+            return false;
+        r = derive( r, a );
+        if( r == empty )
+            return false;
+    }
+    return expressionList[r].nullable;
+}
+
+template< typename Char >
+DFA< int, Char > DerivativeAutomaton< Char >::toDFA() {
+    DFA< int, Char > dfa;
+    std::unordered_map< int, int > state; // Expressão -> estado
+    std::vector< int > queue;
+    if( root != empty ) {
+        state[root] = 0;
+        queue.push_back( root );
+    }
+    for( std::size_t q = 0; q < queue.size(); ++q ) {
+        if( expressionList[queue[q]].nullable )
+            dfa.finalStates.insert( q );
+        for( std::size_t a = 0; a < alphabet.size(); ++a ) {
+            int d = derive( queue[q], a );
+            if( d == empty )
+                continue;
+            auto pair = state.insert({ d, (int) queue.size() });
+            if( pair.second )
+                queue.push_back( d );
+            dfa.delta.insert( {(int) q, alphabet[a]}, pair.first->second );
+            dfa.alphabet.insert( alphabet[a] );
+        }
+    }
+    for( std::size_t q = 0; q < queue.size(); ++q )
+        dfa.states.insert( dfa.states.end(), q );
+    dfa.initialState = 0;
+    return dfa;
+}
+
+template< typename Char >
+std::size_t DerivativeAutomaton< Char >::expressions() const {
+    return expressionList.size();
+}
+
+template< typename Char >
+DFA< int, Char > brzozowski(
+        const BinaryTree< Either<Char, Epsilon, Operator> >& tree )
+{
+    return DerivativeAutomaton< Char >( tree ).toDFA();
+}
+
+#endif // DERIVATIVES_H
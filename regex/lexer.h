@@ -0,0 +1,290 @@
+/* lexer.h
+ * Analisador léxico gerado a partir de uma lista de expressões regulares.
+ *
+ * Cada regra associa uma expressão regular a um token e a uma
+ * prioridade. Os autômatos de Thompson das regras são combinados num
+ * único NFAe, por transições-épsilon a partir de um novo estado inicial,
+ * e determinizados juntos. Cada estado do DFA resultante que contém
+ * estados finais de alguma regra recebe o token da regra vencedora: a
+ * de maior prioridade e, em caso de empate, a que aparece primeiro.
+ *
+ * Os tokens são usados como rótulos iniciais de refinePartition; assim,
+ * a minimização jamais une estados que reconhecem tokens diferentes.
+ *
+ * A leitura usa a regra do casamento mais longo (maximal munch): a
+ * partir do início de cada token, o autômato avança até alcançar o
+ * estado morto ou o fim da entrada, e o token reconhecido é o do último
+ * estado final visitado. Caso nenhum estado final seja visitado,
+ * lexical_error é lançado.
+ *
+ * Os símbolos lidos após o último estado final são lidos novamente pelo
+ * token seguinte; sem outros cuidados, isso custaria tempo quadrático
+ * (com as regras a e a*b, num texto só com a, cada token tem tamanho 1,
+ * mas a leitura só para no fim do texto). Como em Searcher
+ * (automaton/search.h), guardamos os pares (posição, estado) visitados
+ * após o último estado final de cada token, a partir dos quais nenhum
+ * estado final é alcançado; uma leitura que chegue a um deles termina
+ * ali. Assim, a entrada inteira custa O(n·m) leituras, em que m é a
+ * quantidade de estados do autômato.
+ *
+ * Apenas símbolos de um byte são suportados.
+ */
+#ifndef LEXER_H
+#define LEXER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "exceptions.h"
+#include "automaton/minimization.h"
+#include "regex/parsing.h"
+#include "regex/thompson.h"
+#include "utility/bitset.h"
+
+template< typename Char >
+class Lexer {
+    static_assert( sizeof(Char) == 1, "Lexer supports only byte-sized symbols" );
+
+public:
+    /* Regra do analisador: palavras reconhecidas pela expressão regex
+     * são lidas como o token id, que deve ser não-negativo. */
+    struct Rule {
+        std::basic_string< Char > regex;
+        int id;
+        int priority;
+    };
+
+    /* Token lido, que ocupa as posições [begin, end) da entrada. */
+    struct Token {
+        int id;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    /* Constrói o analisador para as regras passadas.
+     *
+     * Exceções lançadas:
+     *  syntax_error - caso alguma das expressões seja inválida;
+     *  token_error  - caso um operador não previsto seja encontrado. */
+    explicit Lexer( const std::vector< Rule >& );
+
+    /* Divide a entrada delimitada pelo intervalo [begin, end) em tokens.
+     *
+     * Como parte da entrada é lida mais de uma vez, os iteradores devem
+     * permitir múltiplas passadas; iteradores de entrada (como
+     * std::istreambuf_iterator) não são suportados.
+     *
+     * Exceção lançada:
+     *  lexical_error - caso nenhuma regra reconheça um prefixo não-vazio
+     *                  do restante da entrada; o índice da exceção é a
+     *                  posição em que o token deveria começar. */
+    template< typename ForwardIterator >
+    std::vector< Token > tokenize( ForwardIterator begin,
+                                   ForwardIterator end ) const;
+
+    /* Quantidade de estados do autômato mínimo, incluindo o estado morto. */
+    std::size_t states() const;
+
+private:
+    std::size_t k; // Símbolos do alfabeto, mais um para os demais bytes
+    int symbolIndex[256];
+    std::vector< int > table; // table[q*k + a]
+    std::vector< int > token; // Token reconhecido em cada estado, ou -1
+    int start;
+    int dead;
+};
+
+// Implementação
+
+template< typename Char >
+Lexer< Char >::Lexer( const std::vector< Rule >& rules ) {
+    /* Combina os autômatos de Thompson das regras num único NFAe, em forma
+     * de listas de adjacência. Os estados da regra i são deslocados em
+     * offset; o estado 0 é o novo estado inicial. */
+    std::vector< NFAe< int, Char > > automata;
+    for( const Rule& rule : rules )
+        automata.push_back( thompson( parse( rule.regex ) ) );
+
+    for( int& i : symbolIndex )
+        i = -1;
+    int symbols = 0;
+    for( const auto& nfae : automata )
+        for( Char c : nfae.alphabet )
+            if( symbolIndex[(unsigned char) c] == -1 )
+                symbolIndex[(unsigned char) c] = symbols++;
+    k = symbols + 1;
+    for( int& i : symbolIndex )
+        if( i == -1 )
+            i = symbols;
+
+    std::vector< std::vector< int > > epsilonSuccessors( 1 );
+    std::vector< std::vector< int > > successors( k );
+    std::vector< int > rule( 1, -1 ); // Regra de cada estado final, ou -1
+    for( std::size_t i = 0; i < automata.size(); ++i ) {
+        const NFAe< int, Char >& nfae = automata[i];
+        int offset = rule.size();
+        std::size_t n = nfae.states.size();
+        epsilonSuccessors.resize( offset + n );
+        successors.resize( (offset + n) * k );
+        rule.resize( offset + n, -1 );
+
+        epsilonSuccessors[0].push_back( offset + nfae.initialState );
+        for( int q : nfae.finalStates )
+            rule[offset + q] = i;
+        for( const auto& pair : nfae.delta.symbolTransitions() ) {
+            std::vector< int >& out = successors[
+                (offset + pair.first.first) * k +
+                symbolIndex[(unsigned char) pair.first.second]];
+            for( int r : pair.second )
+                out.push_back( offset + r );
+        }
+        for( const auto& pair : nfae.delta.epsilonTransitions() ) {
+            std::vector< int >& out = epsilonSuccessors[offset + pair.first];
+            for( int r : pair.second )
+                out.push_back( offset + r );
+        }
+    }
+    std::size_t n = rule.size();
+
+    auto close = [&]( Bitset& s ) {
+        std::vector< int > stack;
+        s.forEach( [&]( std::size_t q ) { stack.push_back( q ); } );
+        while( !stack.empty() ) {
+            int q = stack.back();
+            stack.pop_back();
+            for( int r : epsilonSuccessors[q] )
+                if( !s.test( r ) ) {
+                    s.set( r );
+                    stack.push_back( r );
+                }
+        }
+    };
+
+    /* Construção dos subconjuntos. O subconjunto vazio (o estado morto)
+     * é numerado primeiro, para que a tabela seja completa. label[q] é
+     * 1 mais o índice da regra vencedora no estado q, ou 0. */
+    std::unordered_map< Bitset, int, BitsetHash > ids;
+    std::vector< Bitset > subsets;
+    std::vector< int > delta, label;
+    auto intern = [&]( const Bitset& s ) {
+        auto pair = ids.insert({ s, (int) subsets.size() });
+        if( pair.second ) {
+            subsets.push_back( s );
+            int winner = -1;
+            s.forEach( [&]( std::size_t q ) {
+                int i = rule[q];
+                if( i != -1 && ( winner == -1 ||
+                        rules[i].priority > rules[winner].priority ) )
+                    winner = i;
+            });
+            label.push_back( winner + 1 );
+        }
+        return pair.first->second;
+    };
+
+    intern( Bitset( n ) );
+    Bitset initial( n );
+    initial.set( 0 );
+    close( initial );
+    int initialId = intern( initial );
+
+    Bitset target( n );
+    for( std::size_t q = 0; q < subsets.size(); ++q )
+        for( std::size_t a = 0; a < k; ++a ) {
+            target.clear();
+            subsets[q].forEach( [&]( std::size_t p ) {
+                for( int r : successors[p * k + a] )
+                    target.set( r );
+            });
+            close( target );
+            delta.push_back( intern( target ) );
+        }
+
+    /* Minimização, sem unir estados de tokens diferentes: os rótulos
+     * passam a ser 1 mais o token da regra vencedora, ou 0. */
+    for( int& l : label )
+        if( l != 0 )
+            l = 1 + rules[l - 1].id;
+    std::vector< int > block = refinePartition( delta, k, label );
+    std::size_t m = 0;
+    for( int b : block )
+        m = std::max< std::size_t >( m, b + 1 );
+
+    table.resize( m * k );
+    token.resize( m );
+    for( std::size_t q = 0; q < subsets.size(); ++q ) {
+        token[block[q]] = label[q] - 1;
+        for( std::size_t a = 0; a < k; ++a )
+            table[block[q] * k + a] = block[delta[q * k + a]];
+    }
+    start = block[initialId];
+    dead = block[0];
+}
+
+template< typename Char >
+template< typename ForwardIterator >
+auto Lexer< Char >::tokenize( ForwardIterator begin,
+        ForwardIterator end ) const -> std::vector< Token >
+{
+    std::vector< Token > tokens;
+    std::size_t position = 0;
+
+    /* failed[i] contém os estados a partir dos quais, na posição i,
+     * nenhum estado final é alcançado; horizon é a maior posição com
+     * algum estado em failed. trail contém os pares visitados pelo
+     * token atual após o seu último estado final. */
+    std::unordered_map< std::size_t, std::vector< int > > failed;
+    std::vector< std::pair< std::size_t, int > > trail;
+    std::size_t horizon = 0;
+
+    while( begin != end ) {
+        /* Avança até o estado morto, guardando o último estado final;
+         * a leitura recomeça logo após o token reconhecido. */
+        int q = start;
+        int id = -1;
+        std::size_t i = position, last = position;
+        ForwardIterator resume = begin;
+        trail.clear();
+        for( ForwardIterator it = begin; it != end; ) {
+            q = table[q * k + symbolIndex[(unsigned char) *it]];
+            if( q == dead )
+                break;
+            ++it;
+            ++i;
+            if( i <= horizon ) {
+                auto f = failed.find( i );
+                if( f != failed.end() && std::find( f->second.begin(),
+                            f->second.end(), q ) != f->second.end() )
+                    break;
+            }
+            if( token[q] != -1 ) {
+                id = token[q];
+                last = i;
+                resume = it;
+                trail.clear();
+            }
+            else
+                trail.push_back({ i, q });
+        }
+        if( id == -1 )
+            throw lexical_error( "No rule matches the input.", position );
+        for( const auto& pair : trail ) {
+            failed[pair.first].push_back( pair.second );
+            horizon = std::max( horizon, pair.first );
+        }
+        tokens.push_back({ id, position, last });
+        begin = resume;
+        position = last;
+    }
+    return tokens;
+}
+
+template< typename Char >
+std::size_t Lexer< Char >::states() const {
+    return token.size();
+}
+
+#endif // LEXER_H
@@ -5,6 +5,8 @@
 #ifndef PARSING_H
 #define PARSING_H
 
+#include <cstddef>
+#include <iterator>
 #include <vector>
 #include "epsilon.h"
 #include "exceptions.h"
@@ -18,7 +20,8 @@
  * O retorno é uma BinaryTree de Either<Char, Epsilon, Operator>,
  * em que Char é o tipo dos elementos do contêiner.
  *
- * Esta função simplesmente coordena o esforço das próximas funções.
+ * Os tokens são lidos diretamente do contêiner, sem vetores
+ * intermediários, e a árvore é construída por parseTokens.
  *
  * Exceção lançada:
  *  syntax_error - erros de sintaxe, como parênteses desbalanceados
@@ -52,6 +55,14 @@ template< typename ForwardIterator >
 auto tokenize( ForwardIterator begin, ForwardIterator end ) ->
     TokenVector< typename unqualified<decltype(*begin)>::type >;
 
+/* Lê o próximo token da sequência [i, end), como em tokenize, e avança
+ * i para depois dele. Retorna false caso não haja mais tokens.
+ *
+ * Esta função é usada tanto por tokenize quanto por parse. */
+template< typename ForwardIterator, typename Char >
+bool nextToken( ForwardIterator& i, ForwardIterator end,
+                Either<Char, Epsilon, Operator, Parentheses>& token );
+
 /* Explicita os operadores de concatenação numa sequência de tokens.
  * Mas precisamente, um Operator::Concatenation será adicionado
  * antes de cada:
@@ -69,70 +80,33 @@ template< typename Char >
 TokenVector< Char > explicitConcatenations( const TokenVector< Char >& );
 
 /* Constrói a árvore da expressão regular representada pelo vetor
- * de tokens passado.
+ * de tokens passado. Os operadores de concatenação podem estar
+ * explícitos, como no retorno de explicitConcatenations, ou implícitos,
+ * como no retorno de tokenize.
  *
- * Caso a expressão não esteja sintaticamente correta, a exceção
- * bad_regex é lançada.
+ * Exceção lançada:
+ *  syntax_error - caso a expressão não esteja sintaticamente correta.
  */
 template< typename Char >
 BinaryTree< Either<Char, Epsilon, Operator> >
     buildExpressionTree( const TokenVector< Char >& );
 
-/* Constrói uma subexpressão parentetizada no local apontado.
- * Por exemplo, a expressão 
- *  a.(a|b)
- * é analisada como
- *     .
- *    / \
- *   a  <subexpressão>
- * Esta função espera um TreeIterator apontando para um novo nodo na
- * na árvore, que será substituído pela estrutura adequada.
+/* Constrói a árvore da expressão regular cujos tokens são lidos, um a
+ * um, por next( token ), que retorna false ao fim da expressão. Os
+ * operadores de concatenação podem estar explícitos ou implícitos.
  *
- * Argumentos:
- *  where   Local da árvore em que deve ser construída a subexpressão.
- *  begin   Ponto de início da iteração. Deve apontar para o primeiro
- *          elemento após o abre-parênteses; no exemplo, begin deveria
- *          apontar para o 'a'. Note que este argumento é passado por 
- *          referência; ele será alterado para corresponder ao fecha-
- *          -parênteses terminal, ou a 'end', caso a sentença não contenha
- *          um fecha-parênteses.
- *  end     Limite da iteração. begin jamais será deslocado para além
- *          de end.
+ * A leitura é feita numa única passada, sem recursão: os operadores
+ * binários são tratados por precedência, e apenas os parênteses ainda
+ * abertos são guardados numa pilha. Os nodos são escritos diretamente
+ * na árvore, que reserva espaço para os nodos de uma expressão com
+ * sizeHint tokens (cada token cria, no máximo, dois nodos).
  *
- * Hipóteses sobre os tipos:
- *  TreeIterator    Aponta para um Either cujo primeiro tipo
- *                  é o caractere que está sendo considerado e possui
- *                  ao menos os tipos Epsilon e Operator.
- *  ForwardIterator Aponta para um Either que satisfaz todas as exigências
- *                  acima e também possui o tipo Parentheses.
+ * Exceção lançada:
+ *  syntax_error - caso a expressão não esteja sintaticamente correta.
  */
-template< typename TreeIterator, typename ForwardIterator >
-void buildSubexpression( TreeIterator     where,
-                         ForwardIterator& begin,
-                         ForwardIterator  end );
-
-/* Similar à função anterior, mas interrompe a construção na primeira
- * barra vertical encontrada.
- * begin será deslocado até a primeira barra ou até end. */
-template< typename TreeIterator, typename ForwardIterator >
-void buildUntilBar( TreeIterator     where,
-                    ForwardIterator& begin,
-                    ForwardIterator  end );
-
-/* Similar à função anterior, mas interrompe a construção no primeiro
- * operador de concatenação encontrado.
- * begin será deslocado até a primeira concatenação ou até end. */
-template< typename TreeIterator, typename ForwardIterator >
-void buildUntilCat( TreeIterator     where,
-                    ForwardIterator& begin,
-                    ForwardIterator  end );
-
-/* Similar à função anterior, mas constrói apenas os operadores unários.
- * begin será deslocado até o primeiro operador binário ou até end. */
-template< typename TreeIterator, typename ForwardIterator >
-void buildUnary( TreeIterator     where,
-                 ForwardIterator& begin,
-                 ForwardIterator  end );
+template< typename Char, typename NextToken >
+BinaryTree< Either<Char, Epsilon, Operator> >
+    parseTokens( NextToken next, std::size_t sizeHint = 0 );
 
 // Implementação
 template< typename Container >
@@ -141,45 +115,60 @@ auto parse( const Container& c )
         typename unqualified<decltype(*c.begin())>::type, Epsilon, Operator
        >>
 {
-    return buildExpressionTree(
-                explicitConcatenations(
-                    tokenize( c.begin(), c.end() )
-                )
-            );
+    typedef typename unqualified<decltype(*c.begin())>::type Char;
+    auto i = c.begin();
+    auto end = c.end();
+    auto next = [&]( Either<Char, Epsilon, Operator, Parentheses>& token ) {
+        return nextToken( i, end, token );
+    };
+    return parseTokens< Char >( next, std::distance( i, end ) );
 }
 
 template< typename ForwardIterator >
 auto tokenize( ForwardIterator begin, ForwardIterator end ) ->
     TokenVector< typename unqualified<decltype(*begin)>::type >
 {
-    TokenVector< typename unqualified<decltype(*begin)>::type > v;
-
-    bool nextIsLiteral = false;
-
-    for( ForwardIterator i = begin; i != end; ++i ) {
-        if( nextIsLiteral ) {
-            v.push_back( *i );
-            nextIsLiteral = false;
-            continue;
-        }
-        switch( char(*i) ) {
-            case ':' : v.push_back( Operator::SigmaClosure    );    break;
-            case '*' : v.push_back( Operator::KleneeClosure   );    break;
-            case '+' : v.push_back( Operator::PositiveClosure );    break;
-            case '?' : v.push_back( Operator::Optional        );    break;
-            case '|' : v.push_back( Operator::VerticalBar     );    break;
-            case '(' : v.push_back( Parentheses::Left         );    break;
-            case ')' : v.push_back( Parentheses::Right        );    break;
-            case '&' : v.push_back( epsilon                   );    break;
-            case '.' : /* não adicionaremos pontos */               break;
-            case '\\': nextIsLiteral = true;                        break;
-            default  : v.push_back( *i );                           break;
-        }
-    } // fim for
-
+    typedef typename unqualified<decltype(*begin)>::type Char;
+    TokenVector< Char > v;
+    Either<Char, Epsilon, Operator, Parentheses> token;
+    while( nextToken( begin, end, token ) )
+        v.push_back( token );
     return v;
 }
 
+template< typename ForwardIterator, typename Char >
+bool nextToken( ForwardIterator& i, ForwardIterator end,
+                Either<Char, Epsilon, Operator, Parentheses>& token )
+{
+    TokenType type = TokenType::Symbol;
+    ForwardIterator symbol = i;
+    if( !readToken( i, end, type, symbol ) )
+        return false;
+    switch( type ) {
+        case TokenType::Symbol:           token = Char( *symbol );    break;
+        case TokenType::Epsilon:          token = epsilon;            break;
+        case TokenType::KleneeClosure:
+            token = Operator::KleneeClosure;
+            break;
+        case TokenType::PositiveClosure:
+            token = Operator::PositiveClosure;
+            break;
+        case TokenType::Optional:         token = Operator::Optional; break;
+        case TokenType::SigmaClosure:
+            token = Operator::SigmaClosure;
+            break;
+        case TokenType::Concatenation:
+            token = Operator::Concatenation;
+            break;
+        case TokenType::VerticalBar:
+            token = Operator::VerticalBar;
+            break;
+        case TokenType::LeftParentheses:  token = Parentheses::Left;  break;
+        case TokenType::RightParentheses: token = Parentheses::Right; break;
+    }
+    return true;
+}
+
 template< typename Char >
 TokenVector< Char > explicitConcatenations( const TokenVector< Char >& in ) {
     TokenVector< Char > out;
@@ -222,105 +211,126 @@ template< typename Char >
 BinaryTree< Either<Char, Epsilon, Operator> >
     buildExpressionTree( const TokenVector< Char >& v )
 {
-    BinaryTree< Either<Char, Epsilon, Operator> > tree;
     auto iterator = v.begin();
-    buildSubexpression( tree.root(), iterator, v.end() );
-
-    if( iterator != v.end() )
-        throw syntax_error( "Unbalanced parentheses" );
-
-    return tree;
+    auto next = [&]( Either<Char, Epsilon, Operator, Parentheses>& token ) {
+        if( iterator == v.end() )
+            return false;
+        token = *iterator++;
+        return true;
+    };
+    return parseTokens< Char >( next, v.size() );
 }
 
-template< typename TreeIterator, typename ForwardIterator >
-void buildSubexpression( TreeIterator     nodeIterator,
-                         ForwardIterator& currentToken,
-                         ForwardIterator  iterationLimit )
-{
-    buildUntilBar( nodeIterator, currentToken, iterationLimit );
-    while( currentToken != iterationLimit        &&
-          *currentToken == Operator::VerticalBar )
-    {
-        nodeIterator.rightAscent();
-        *nodeIterator = Operator::VerticalBar;
-        ++currentToken;
-        buildUntilBar( nodeIterator.makeRightChild(),
-                       currentToken, iterationLimit );
-    }
-}
-
-template< typename TreeIterator, typename ForwardIterator >
-void buildUntilBar( TreeIterator     nodeIterator,
-                    ForwardIterator& currentToken,
-                    ForwardIterator  iterationLimit )
+/* A árvore é construída de cima para baixo, por ascensões (veja
+ * BinaryTree::iterator::rightAscent): o primeiro operando de cada
+ * operador é escrito no nodo que receberá a subexpressão inteira, e,
+ * quando o operador é lido, este nodo ascende, tornando-se o operador,
+ * e o operando seguinte é escrito no novo filho da direita.
+ *
+ * Por isso, cada nível de precedência guarda o nodo em que estão sendo
+ * construídos os seus operandos:
+ *  subexpression - a subexpressão entre parênteses, cujos operandos
+ *                  são separados por barras verticais;
+ *  untilBar      - o operando atual da barra vertical, cujos operandos
+ *                  são separados por concatenações;
+ *  untilCat      - o operando atual da concatenação, cujos operandos
+ *                  são separados por operadores libra;
+ *  unary         - o operando atual do operador libra: um símbolo, um
+ *                  épsilon ou uma subexpressão, seguidos dos operadores
+ *                  unários.
+ * Ao abrir parênteses, os três primeiros nodos são empilhados, e o
+ * operando atual passa a ser a nova subexpressão. */
+template< typename Char, typename NextToken >
+BinaryTree< Either<Char, Epsilon, Operator> >
+    parseTokens( NextToken next, std::size_t sizeHint )
 {
-    buildUntilCat( nodeIterator, currentToken, iterationLimit );
-    while( currentToken != iterationLimit        &&
-          *currentToken == Operator::Concatenation )
-    {
-        nodeIterator.rightAscent();
-        *nodeIterator = Operator::Concatenation;
-        ++currentToken;
-        buildUntilCat( nodeIterator.makeRightChild(), 
-                       currentToken, iterationLimit );
-    }
-}
+    typedef BinaryTree< Either<Char, Epsilon, Operator> > Tree;
+    typedef typename Tree::iterator TreeIterator;
+    struct Level {
+        TreeIterator subexpression;
+        TreeIterator untilBar;
+        TreeIterator untilCat;
+    };
 
-template< typename TreeIterator, typename ForwardIterator >
-void buildUntilCat( TreeIterator     nodeIterator,
-                    ForwardIterator& currentToken,
-                    ForwardIterator  iterationLimit )
-{
-    buildUnary( nodeIterator, currentToken, iterationLimit );
-    while( currentToken != iterationLimit        &&
-          *currentToken == Operator::SigmaClosure )
-    {
-        nodeIterator.rightAscent();
-        *nodeIterator = Operator::SigmaClosure;
-        ++currentToken;
-        buildUnary( nodeIterator.makeRightChild(),
-                    currentToken, iterationLimit );
-    }
-}
+    Tree tree;
+    tree.reserve( 2 * sizeHint + 1 );
+    Level level = { tree.root(), tree.root(), tree.root() };
+    TreeIterator unary = tree.root();
+    std::vector< Level > parentheses;
 
-template< typename TreeIterator, typename ForwardIterator >
-void buildUnary( TreeIterator     nodeIterator,
-                 ForwardIterator& currentToken,
-                 ForwardIterator  iterationLimit )
-{
-    // Como o tipo do caractere desapareceu até aqui, temos de reconstruí-lo:
-    typedef typename extract_head_type< 
-                typename TreeIterator::value_type
-            >::type Char;
+    Either<Char, Epsilon, Operator, Parentheses> token;
+    bool hasToken = next( token );
+    bool expectOperand = true;
+    while( true ) {
+        if( expectOperand ) {
+            if( !hasToken )
+                throw syntax_error( "Lacking inner symbol" );
+            if( token == Parentheses::Left ) {
+                parentheses.push_back( level );
+                level = { unary, unary, unary };
+            }
+            else if( token.template is<Char>() ) {
+                *unary = token.operator Char();
+                expectOperand = false;
+            }
+            else if( token.template is<Epsilon>() ) {
+                *unary = epsilon;
+                expectOperand = false;
+            }
+            else if( token == Parentheses::Right )
+                throw syntax_error( "Lacking inner symbol" );
+            else
+                throw syntax_error( "Wrong operator sequence" );
+            hasToken = next( token );
+            continue;
+        }
 
-    if( *currentToken == Parentheses::Left ) {
-        ++currentToken;
-        buildSubexpression( nodeIterator, currentToken, iterationLimit );
-        if( *currentToken != Parentheses::Right )
-            throw syntax_error( "Unbalanced parentheses" );
-    } 
-    else if( currentToken->template is<Char>() )
-        *nodeIterator = currentToken->operator Char();
-    else if( currentToken->template is<Epsilon>() )
-        *nodeIterator = epsilon;
-    else if( *currentToken == Parentheses::Right )
-        throw syntax_error( "Lacking inner symbol" );
-    else
-        throw syntax_error( "Wrong operator sequence" );
+        // Já lemos um operando; o token atual deve ser um operador.
+        if( !hasToken ) {
+            if( !parentheses.empty() )
+                throw syntax_error( "Unbalanced parentheses" );
+            return tree;
+        }
 
-    ++currentToken;
-    // Já construímos a "base". Agora, adicionemos os operadores unários:
-    while( currentToken != iterationLimit &&
-            (
-              *currentToken == Operator::KleneeClosure   ||
-              *currentToken == Operator::PositiveClosure ||
-              *currentToken == Operator::Optional
-            )
-         )
-    {
-        nodeIterator.rightAscent();
-        *nodeIterator = currentToken->operator Operator();
-        ++currentToken;
+        if( token == Operator::KleneeClosure   ||
+            token == Operator::PositiveClosure ||
+            token == Operator::Optional )
+        {
+            unary.rightAscent();
+            *unary = token.operator Operator();
+        }
+        else if( token == Operator::SigmaClosure ) {
+            level.untilCat.rightAscent();
+            *level.untilCat = Operator::SigmaClosure;
+            unary = level.untilCat.makeRightChild();
+            expectOperand = true;
+        }
+        else if( token == Operator::VerticalBar ) {
+            level.subexpression.rightAscent();
+            *level.subexpression = Operator::VerticalBar;
+            level.untilBar = level.subexpression.makeRightChild();
+            level.untilCat = unary = level.untilBar;
+            expectOperand = true;
+        }
+        else if( token == Parentheses::Right ) {
+            if( parentheses.empty() )
+                throw syntax_error( "Unbalanced parentheses" );
+            unary = level.subexpression;
+            level = parentheses.back();
+            parentheses.pop_back();
+        }
+        else {
+            /* Concatenação, explícita ou implícita (um operando logo
+             * após outro); no segundo caso, o token atual é o início do
+             * próximo operando e ainda não foi consumido. */
+            level.untilBar.rightAscent();
+            *level.untilBar = Operator::Concatenation;
+            level.untilCat = unary = level.untilBar.makeRightChild();
+            expectOperand = true;
+            if( token != Operator::Concatenation )
+                continue;
+        }
+        hasToken = next( token );
     }
 }
 
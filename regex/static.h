@@ -0,0 +1,348 @@
+/* static.h
+ * Construção, em tempo de compilação, de autômatos finitos
+ * determinísticos a partir de expressões regulares literais.
+ *
+ * Expressões conhecidas durante a compilação não precisam passar por
+ * parse, thompson, determinização e minimização na inicialização do
+ * programa. staticDFA é uma função constexpr que analisa a expressão
+ * (com a mesma sintaxe e os mesmos erros de regex/parsing.h), calcula
+ * as posições do autômato de Glushkov (como em regex/bitParallel.h) e
+ * determiniza-o pela construção dos subconjuntos, produzindo uma tabela
+ * de tamanho fixo:
+ *
+ *     constexpr auto identifier = staticDFA( "(a|b|c)(a|b|c|0|1)*" );
+ *     static_assert( identifier.accepts( "ab0" ), "" );
+ *
+ * Como a tabela é uma constante, o compilador pode propagá-la e
+ * especializar as transições no local de uso.
+ *
+ * Cada posição (folha da expressão) ocupa um bit de uma palavra de
+ * 64 bits; assim, as expressões podem ter até 63 posições, pois o bit 0
+ * representa o início da leitura. O autômato resultante não é mínimo.
+ *
+ * Erros de sintaxe e excessos de tamanho lançam exceções; numa
+ * avaliação constante, isso impede a compilação.
+ */
+#ifndef STATIC_H
+#define STATIC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include "exceptions.h"
+#include "regex/tokens.h"
+
+/* Autômato finito determinístico de até MaxStates estados, incluindo o
+ * estado morto (0). O estado inicial é o estado 1.
+ *
+ * Os bytes que aparecem na expressão são agrupados em classes,
+ * numeradas a partir de 1; a classe 0 contém os demais bytes, e leva
+ * sempre ao estado morto. */
+template< std::size_t MaxStates = 64 >
+struct StaticDFA {
+    static_assert( MaxStates >= 2 && MaxStates <= 65536,
+        "StaticDFA needs between 2 and 65536 states" );
+
+    /* Quantidade máxima de classes de bytes (até 63 posições, mais a
+     * classe 0). */
+    static constexpr std::size_t maxClasses = 64;
+
+    std::uint8_t byteClass[256];
+    std::uint16_t table[MaxStates][maxClasses];
+    bool finalStates[MaxStates];
+    std::size_t states;
+    std::size_t classes;
+
+    constexpr StaticDFA() :
+        byteClass{}, table{}, finalStates{}, states( 0 ), classes( 0 )
+    {}
+
+    /* Determina se o autômato aceita a palavra delimitada pelo
+     * intervalo [begin, end), ou a cadeia terminada em '\0'. */
+    template< typename ForwardIterator >
+    constexpr bool accepts( ForwardIterator begin, ForwardIterator end ) const;
+    constexpr bool accepts( const char * ) const;
+};
+
+/* Constrói o autômato que reconhece a expressão regular passada.
+ *
+ * Exceções lançadas:
+ *  syntax_error      - caso a expressão não seja sintaticamente correta;
+ *  std::length_error - caso a expressão possua mais de 63 posições, ou
+ *                      o autômato precise de mais de MaxStates estados. */
+template< std::size_t MaxStates = 64, std::size_t N >
+constexpr StaticDFA< MaxStates > staticDFA( const char (&regex)[N] );
+
+// Implementação
+
+namespace StaticRegex {
+
+struct Token {
+    TokenType type;
+    char symbol;
+};
+
+/* Nodo da árvore de expressão; left e right são índices em Tree::nodes,
+ * ou -1. Os operadores unários usam apenas left. */
+struct Node {
+    TokenType type;
+    char symbol;
+    int left;
+    int right;
+};
+
+/* Vetores de tamanho fixo usados pela construção. N é o tamanho da
+ * expressão (incluindo o '\0'); como a tokenização insere no máximo
+ * uma concatenação por caractere, 2N tokens e nodos são suficientes. */
+template< std::size_t N >
+struct Tree {
+    Token tokens[2 * N];
+    std::size_t tokenCount;
+    Node nodes[2 * N];
+    std::size_t nodeCount;
+    std::size_t current; // Próximo token a ser lido pelo parser
+
+    constexpr Tree() :
+        tokens{}, tokenCount( 0 ), nodes{}, nodeCount( 0 ), current( 0 )
+    {}
+
+    constexpr void push( TokenType type, char symbol = 0 ) {
+        tokens[tokenCount++] = Token{ type, symbol };
+    }
+
+    constexpr int node( TokenType type, char symbol, int left, int right ) {
+        nodes[nodeCount] = Node{ type, symbol, left, right };
+        return nodeCount++;
+    }
+
+    constexpr bool at( TokenType type ) const {
+        return current < tokenCount && tokens[current].type == type;
+    }
+};
+
+/* Equivalente a tokenize seguido de explicitConcatenations. */
+template< std::size_t N >
+constexpr void tokenize( Tree< N >& tree, const char (&regex)[N] ) {
+    // A expressão termina no primeiro '\0'.
+    const char * end = regex;
+    while( end + 1 < regex + N && *end != '\0' )
+        ++end;
+
+    bool skipNext = true; // Não há concatenação no começo da expressão.
+    const char * i = regex;
+    const char * symbol = regex;
+    TokenType type = TokenType::Symbol;
+    while( readToken( i, end, type, symbol ) ) {
+        bool operand = type == TokenType::Symbol ||
+                       type == TokenType::Epsilon ||
+                       type == TokenType::LeftParentheses;
+        if( !skipNext && operand )
+            tree.push( TokenType::Concatenation );
+        skipNext = type == TokenType::VerticalBar ||
+                   type == TokenType::SigmaClosure ||
+                   type == TokenType::LeftParentheses;
+        tree.push( type, *symbol );
+    }
+}
+
+/* Parser descendente recursivo, com a mesma precedência e os mesmos
+ * erros de parse (regex/parsing.h). */
+template< std::size_t N >
+constexpr int parseBinary( Tree< N >&, int level );
+
+template< std::size_t N >
+constexpr int parseUnary( Tree< N >& tree ) {
+    int base = -1;
+    if( tree.current == tree.tokenCount )
+        throw syntax_error( "Lacking inner symbol" );
+    const Token& t = tree.tokens[tree.current];
+    if( t.type == TokenType::LeftParentheses ) {
+        ++tree.current;
+        base = parseBinary( tree, 0 );
+        if( !tree.at( TokenType::RightParentheses ) )
+            throw syntax_error( "Unbalanced parentheses" );
+    }
+    else if( t.type == TokenType::Symbol || t.type == TokenType::Epsilon )
+        base = tree.node( t.type, t.symbol, -1, -1 );
+    else if( t.type == TokenType::RightParentheses )
+        throw syntax_error( "Lacking inner symbol" );
+    else
+        throw syntax_error( "Wrong operator sequence" );
+
+    ++tree.current;
+    while( tree.at( TokenType::KleneeClosure ) ||
+           tree.at( TokenType::PositiveClosure ) ||
+           tree.at( TokenType::Optional ) )
+        base = tree.node( tree.tokens[tree.current++].type, 0, base, -1 );
+    return base;
+}
+
+/* Operadores binários, do menos ao mais prioritário; todos associam-se
+ * da esquerda para a direita. */
+constexpr TokenType binaryOperators[] = {
+    TokenType::VerticalBar, TokenType::Concatenation, TokenType::SigmaClosure
+};
+
+template< std::size_t N >
+constexpr int parseBinary( Tree< N >& tree, int level ) {
+    if( level == 3 )
+        return parseUnary( tree );
+    int left = parseBinary( tree, level + 1 );
+    while( tree.at( binaryOperators[level] ) ) {
+        ++tree.current;
+        int right = parseBinary( tree, level + 1 );
+        left = tree.node( binaryOperators[level], 0, left, right );
+    }
+    return left;
+}
+
+/* Informações de Glushkov de uma subárvore: se ela reconhece a palavra
+ * vazia e as posições que podem iniciá-la e terminá-la. */
+struct Glushkov {
+    bool nullable;
+    std::uint64_t first;
+    std::uint64_t last;
+};
+
+/* Conjuntos de posições da construção de Glushkov. */
+struct Positions {
+    std::size_t count; // As posições são 1, 2, ..., count
+    char symbol[64];
+    std::uint64_t follow[64]; // follow[0]: posições iniciais
+
+    constexpr Positions() : count( 0 ), symbol{}, follow{} {}
+
+    constexpr void link( std::uint64_t from, std::uint64_t to ) {
+        for( std::size_t p = 0; p < 64; ++p )
+            if( from >> p & 1 )
+                follow[p] |= to;
+    }
+};
+
+template< std::size_t N >
+constexpr Glushkov positions( const Tree< N >& tree, int index,
+                              Positions& pos )
+{
+    const Node& node = tree.nodes[index];
+    if( node.type == TokenType::Epsilon )
+        return Glushkov{ true, 0, 0 };
+    if( node.type == TokenType::Symbol ) {
+        if( pos.count == 63 )
+            throw std::length_error( "Too many positions for StaticDFA." );
+        std::size_t p = ++pos.count;
+        pos.symbol[p] = node.symbol;
+        return Glushkov{ false, std::uint64_t(1) << p, std::uint64_t(1) << p };
+    }
+
+    Glushkov x = positions( tree, node.left, pos );
+    switch( node.type ) {
+        case TokenType::KleneeClosure:
+            pos.link( x.last, x.first );
+            return Glushkov{ true, x.first, x.last };
+        case TokenType::PositiveClosure:
+            pos.link( x.last, x.first );
+            return x;
+        case TokenType::Optional:
+            return Glushkov{ true, x.first, x.last };
+        default:
+            break;
+    }
+
+    Glushkov y = positions( tree, node.right, pos );
+    switch( node.type ) {
+        case TokenType::VerticalBar:
+            return Glushkov{ x.nullable || y.nullable,
+                             x.first | y.first, x.last | y.last };
+        case TokenType::Concatenation:
+            pos.link( x.last, y.first );
+            return Glushkov{ x.nullable && y.nullable,
+                             x.first | (x.nullable ? y.first : 0),
+                             y.last | (y.nullable ? x.last : 0) };
+        default: // x : y, equivalente a x (y x)*
+            pos.link( x.last, y.first | (y.nullable ? x.first : 0) );
+            pos.link( y.last, x.first | (x.nullable ? y.first : 0) );
+            return Glushkov{ x.nullable,
+                             x.first | (x.nullable ? y.first : 0),
+                             x.last | (x.nullable ? y.last : 0) };
+    }
+}
+
+} // namespace StaticRegex
+
+template< std::size_t MaxStates >
+constexpr std::size_t StaticDFA< MaxStates >::maxClasses;
+
+template< std::size_t MaxStates >
+template< typename ForwardIterator >
+constexpr bool StaticDFA< MaxStates >::accepts( ForwardIterator begin,
+        ForwardIterator end ) const
+{
+    std::size_t q = 1;
+    for( ; begin != end && q != 0; ++begin )
+        q = table[q][byteClass[(unsigned char) *begin]];
+    return begin == end && finalStates[q];
+}
+
+template< std::size_t MaxStates >
+constexpr bool StaticDFA< MaxStates >::accepts( const char * word ) const {
+    std::size_t q = 1;
+    for( ; *word != '\0' && q != 0; ++word )
+        q = table[q][byteClass[(unsigned char) *word]];
+    return *word == '\0' && finalStates[q];
+}
+
+template< std::size_t MaxStates, std::size_t N >
+constexpr StaticDFA< MaxStates > staticDFA( const char (&regex)[N] ) {
+    using namespace StaticRegex;
+    Tree< N > tree;
+    tokenize( tree, regex );
+    int root = parseBinary( tree, 0 );
+    if( tree.current != tree.tokenCount )
+        throw syntax_error( "Unbalanced parentheses" );
+
+    Positions pos;
+    Glushkov g = positions( tree, root, pos );
+    pos.follow[0] = g.first;
+    std::uint64_t finalPositions = g.last | (g.nullable ? 1 : 0);
+
+    /* Classes de bytes: cada símbolo distinto da expressão forma uma
+     * classe; mask[c] contém as posições da classe c. */
+    StaticDFA< MaxStates > dfa;
+    std::uint64_t mask[StaticDFA< MaxStates >::maxClasses] = {};
+    dfa.classes = 1;
+    for( std::size_t p = 1; p <= pos.count; ++p ) {
+        std::uint8_t& c = dfa.byteClass[(unsigned char) pos.symbol[p]];
+        if( c == 0 )
+            c = dfa.classes++;
+        mask[c] |= std::uint64_t(1) << p;
+    }
+
+    /* Construção dos subconjuntos. subset[q] é o conjunto de posições
+     * do estado q; o estado morto (0) é o conjunto vazio, e o estado
+     * inicial (1) contém apenas a posição 0. */
+    std::uint64_t subset[MaxStates] = {};
+    subset[1] = 1;
+    dfa.states = 2;
+    for( std::size_t q = 1; q < dfa.states; ++q ) {
+        dfa.finalStates[q] = (subset[q] & finalPositions) != 0;
+        std::uint64_t next = 0;
+        for( std::size_t p = 0; p <= pos.count; ++p )
+            if( subset[q] >> p & 1 )
+                next |= pos.follow[p];
+        for( std::size_t c = 1; c < dfa.classes; ++c ) {
+            std::uint64_t target = next & mask[c];
+            std::size_t r = 0;
+            while( r < dfa.states && subset[r] != target )
+                ++r;
+            if( r == dfa.states ) {
+                if( dfa.states == MaxStates )
+                    throw std::length_error( "Too many states for StaticDFA." );
+                subset[dfa.states++] = target;
+            }
+            dfa.table[q][c] = r;
+        }
+    }
+    return dfa;
+}
+
+#endif // STATIC_H
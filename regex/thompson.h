@@ -5,9 +5,13 @@
 #ifndef THOMPSON_H
 #define THOMPSON_H
 
+#include <algorithm>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
 #include "epsilon.h"
 #include "exceptions.h"
-#include "automaton/compaction.h"
 #include "automaton/nonDeterministicWithEpsilon.h"
 #include "regex/tokens.h"
 #include "utility/binaryTree.h"
@@ -17,241 +21,210 @@
 /* Converte a árvore de expressão de uma expressão regular num
  * autômato finito com transições-épsilon.
  *
- * As demais funções deste cabeçalho são auxiliares e coordenadas
- * por esta função. 
+ * Os estados do autômato retornado são {0, 1, ..., n-1}.
  *
  * Exceção lançada:
  *  token_error - caso algum operador não reconhecido esteja na árvore. */
 template< typename Char >
 NFAe< int, Char > thompson( BinaryTree< Either<Char, Epsilon, Operator> > );
 
-/* Constrói um autômato finito que reconhece apenas a palavra 'c',
- * ou a palavra vazia (no segundo caso).
- *
- * Os autômatos retornados terão exatamente dois estados, um deles
- * terminal e o outro inicial, e exatamente uma transição, do estado
- * inicial para o final. */
-template< typename Char >
-NFAe< int, Char > nfaeTo( Char c );
-template< typename Char >
-NFAe< int, Char > nfaeTo( Epsilon = epsilon );
-
-/* Constrói um autômato finito que reconhece apenas a palavra vazia. */
-
-/* Constrói autômatos finitos equivalentes a fazer as operações de:
- *  - Concatenação    - Operator::Concatenation
- *  - União           - Operator::Union
- *  - Operador sigma  - Operator::SigmaClosure
- *  - Fecho de Klenee - Operator::KleneeClosure
- *  - Fecho positivo  - Operator::PositiveClosure
- *  - Opcional        - Operator::Optional
- * respectivamente. Tanto os autômatos de entrada quanto os de saída
- * devem satisfazer / satisfarão às seguintes exigências: 
- *  - O estado inicial não é reentrante (não existem transições para ele);
- *  - Existe um único estado final, que é diferente do estado inicial;
- *  - Não existem transições partindo do estado final.
- */
-template< typename Char >
-NFAe< int, Char > concatenate( NFAe< int, Char >, NFAe< int, Char > );
-template< typename Char >
-NFAe< int, Char > unite( NFAe< int, Char >, NFAe< int, Char > );
-template< typename Char >
-NFAe< int, Char > sigmaClosure( NFAe< int, Char >, NFAe< int, Char > );
-template< typename Char >
-NFAe< int, Char > klenneClosure( NFAe< int, Char > );
-template< typename Char >
-NFAe< int, Char > positiveClosure( NFAe< int, Char > );
-template< typename Char >
-NFAe< int, Char > optional( NFAe< int, Char > );
-
-/* Executa o método de Thompson no nó passado. */
+/* Executa o método de Thompson na subárvore cuja raiz é o nó passado. */
 template< typename TreeIterator >
 NFAe< int, typename extract_head_type< 
                 typename TreeIterator::value_type 
             >::type >
 thompson( TreeIterator t );
 
-/* Executa a junção dos dois autômatos passados. Isto é, dados 
- * dois autômatos a e b, joinAutomaton irá modificar b para que
- * seu conjunto de estados não intersecte com a e retornar um autômato
- * finito r que contêm a e b dentro de si e possui um novo estado 
- * inicial e um novo estado final.
- *
- * Esta função é usada pelas funções concatenate, unite e sigmaClosure
- * para juntar os estados e transições dos dois autômatos num único.
- *
- * b é modificado para permitir que a função chamadora referencie o 
- * estado inicial/final de b dentro do autômato retornado pela variável
- * local. */
-template< typename Char >
-NFAe< int, Char > joinAutomaton( NFAe< int, Char > a, NFAe< int, Char >& b );
-
-/* Extende o autômato passado com um novo estado inicial e um único
- * estado final, também novo. */
-template< typename Char >
-NFAe< int, Char > extendAutomaton( NFAe< int, Char > );
-
-/* Açúcar sintático. Retorna o estado inicial/final do autômato passado. */
-template< typename Char > int initialStateOf( NFAe< int, Char > );
-template< typename Char > int   finalStateOf( NFAe< int, Char > );
-
 // Implementação
 template< typename Char >
 NFAe< int, Char > thompson( BinaryTree< Either<Char, Epsilon, Operator> > t ) {
     return thompson( t.root() );
 }
 
-// Base
-template< typename Char >
-NFAe< int, Char > nfaeTo( Char c ) {
-    return { /* Q */    {0, 1},
-             /* Sigma */{c},
-             /* delta */{ { {0, c}, {1} } 
-                        },
-             /* Q_0 */  0,
-             /* F */    {1}
-    };
-}
-
-template< typename Char >
-NFAe< int, Char > nfaeTo( Epsilon ) {
-    return { /* Q */    {0, 1},
-             /* Sigma */{},
-             /* delta */{ { {0, epsilon}, {1} } 
-                        },
-             /* Q_0 */  0,
-             /* F */    {1}
-    };
-}
-
-// Indução
-template< typename Char >
-NFAe< int, Char > concatenate( NFAe< int, Char > a, NFAe< int, Char > b ) {
-    NFAe< int, Char > r = joinAutomaton( a, b );
-    r.addTransition( initialStateOf( r ), epsilon, initialStateOf( a ) );
-    r.addTransition(   finalStateOf( a ), epsilon, initialStateOf( b ) );
-    r.addTransition(   finalStateOf( b ), epsilon,   finalStateOf( r ) );
-    return r;
-}
-
-template< typename Char >
-NFAe< int, Char > unite( NFAe< int, Char > a, NFAe< int, Char > b ) {
-    NFAe< int, Char > r = joinAutomaton( a, b );
-    r.addTransition( initialStateOf( r ), epsilon, initialStateOf( a ) );
-    r.addTransition( initialStateOf( r ), epsilon, initialStateOf( b ) );
-    r.addTransition(   finalStateOf( a ), epsilon,   finalStateOf( r ) );
-    r.addTransition(   finalStateOf( b ), epsilon,   finalStateOf( r ) );
-    return r;
-}
-
-template< typename Char >
-NFAe< int, Char > sigmaClosure( NFAe< int, Char > a, NFAe< int, Char > b ) {
-    NFAe< int, Char > r = joinAutomaton( a, b );
-    r.addTransition( initialStateOf( r ), epsilon, initialStateOf( a ) );
-    r.addTransition(   finalStateOf( a ), epsilon,   finalStateOf( r ) );
-    r.addTransition(   finalStateOf( a ), epsilon, initialStateOf( b ) );
-    r.addTransition(   finalStateOf( b ), epsilon, initialStateOf( a ) );
-    return r;
-}
-
-template< typename Char >
-NFAe< int, Char > kleneeClosure( NFAe< int, Char > a ) {
-    NFAe< int, Char > r = positiveClosure( a );
-    r.addTransition( initialStateOf( r ), epsilon, finalStateOf( r ) );
-    return r;
-}
-
-template< typename Char >
-NFAe< int, Char > positiveClosure( NFAe< int, Char > a ) {
-    NFAe< int, Char > r = extendAutomaton( a );
-    r.addTransition( initialStateOf( r ), epsilon, initialStateOf( a ) );
-    r.addTransition(   finalStateOf( a ), epsilon, initialStateOf( a ) );
-    r.addTransition(   finalStateOf( a ), epsilon,   finalStateOf( r ) );
-    return r;
-}
-
-template< typename Char >
-NFAe< int, Char > optional( NFAe< int, Char > a ) {
-    a.addTransition( initialStateOf( a ), epsilon, finalStateOf( a ) );
-    return a;
-}
-
-// Função que percorre a árvore
+/* O autômato de cada nó é construído a partir dos autômatos dos filhos,
+ * como no método de Thompson:
+ *  - Símbolo ou épsilon: um estado inicial e um final, ligados pelo
+ *    símbolo (ou por épsilon);
+ *  - Concatenação, união e operador sigma: os autômatos dos dois filhos,
+ *    ligados a um novo estado inicial e a um novo estado final;
+ *  - Fechos de Klenee e positivo: o autômato do filho, ligado a um novo
+ *    estado inicial e a um novo estado final;
+ *  - Opcional: o próprio autômato do filho, com uma transição-épsilon do
+ *    estado inicial para o final.
+ * Cada autômato possui um único estado final, diferente do inicial, do
+ * qual não partem transições, e nenhuma transição chega ao seu estado
+ * inicial.
+ *
+ * A árvore é percorrida uma única vez, em pós-ordem, com uma pilha
+ * explícita. Os estados são numerados por um único contador, e as
+ * transições são acumuladas num único vetor; os autômatos dos filhos não
+ * são copiados nem renumerados, de modo que a construção é linear no
+ * tamanho da expressão (exceto pela montagem final de delta).
+ *
+ * A numeração é a mesma da construção composicional, em que o autômato
+ * do filho direito de um operador binário era renumerado por compact()
+ * ao ser juntado ao do filho esquerdo: os estados do filho esquerdo vêm
+ * antes dos estados do filho direito, seguidos dos novos estados inicial
+ * e final; porém, na numeração do filho direito (rotated), o estado
+ * inicial vem antes dos demais. */
 template< typename TreeIterator >
 NFAe< int, typename extract_head_type< 
                 typename TreeIterator::value_type 
             >::type >
-thompson( TreeIterator t )
+thompson( TreeIterator root )
 {
     typedef typename extract_head_type< 
                 typename TreeIterator::value_type
             >::type Char;
 
-    if( t->template is<Char>() )
-        return nfaeTo( t->operator Char() );
-    if( t->template is<Epsilon>() )
-        return nfaeTo<Char>( epsilon );
-
-    switch( t->template getAs<Operator>() ) {
-        case Operator::KleneeClosure : 
-            return kleneeClosure( thompson(t.leftChild()) );
-        case Operator::PositiveClosure :
-            return positiveClosure( thompson(t.leftChild()) );
-        case Operator::Optional :
-            return optional( thompson(t.leftChild()) );
-        case Operator::SigmaClosure :
-            return sigmaClosure( thompson(t.leftChild()), 
-                                 thompson(t.rightChild()) );
-        case Operator::Concatenation :
-            return concatenate( thompson(t.leftChild()), 
-                                thompson(t.rightChild()) );
-        case Operator::VerticalBar :
-            return unite( thompson(t.leftChild()), 
-                          thompson(t.rightChild()) );
+    // Transição from -> to, pelo símbolo, ou por épsilon se isEpsilon.
+    struct Edge {
+        int from;
+        bool isEpsilon;
+        Char symbol;
+        int to;
+    };
+    std::vector< Edge > edges;
+    std::set< Char > alphabet;
+    int counter = 0;
+    auto link = [&]( int from, int to ) {
+        edges.push_back({ from, true, Char(), to });
     };
-    throw token_error( "Extraneous operator found" );
-}
-
-// Função auxiliare
-template< typename Char >
-NFAe< int, Char > joinAutomaton( NFAe< int, Char > a, NFAe< int, Char >& b ) {
-    NFAe< int, Char > r; // retorno
-
-    // Troquemos b.Q para não intersectar com a.Q.
-    b = compact( b, * a.states.rbegin() + 1 );
-
-    // Unamos os dois conjunto de estados e os dois alfabetos
-    r.states = a.states; 
-    r.states.insert( b.states.begin(), b.states.end() );
-    r.alphabet = a.alphabet; 
-    r.alphabet.insert( b.alphabet.begin(), b.alphabet.end() );
-
-    for( auto pair : a.delta )
-        r.delta.insert( pair.first, pair.second );
-    for( auto pair : b.delta )
-        r.delta.insert( pair.first, pair.second );
-
-    return extendAutomaton( r );
-}
-
-template< typename Char >
-NFAe< int, Char > extendAutomaton( NFAe< int, Char > a ) {
-    int q0, f; // Novo estado inicial e final;
-    a.states.insert( q0 = generateNewState( a ) );
-    a.states.insert(  f = generateNewState( a ) );
-    a.initialState = q0;
-    a.finalStates = {f};
-    return a;
-}
 
-template< typename Char > int initialStateOf( NFAe< int, Char > a ) {
-    return a.initialState;
-}
-template< typename Char > int   finalStateOf( NFAe< int, Char > a ) {
-    return *a.finalStates.begin();
-    /* *set.begin() retorna o primeiro elemento do conjunto; como o
-     * conjunto é unitário, *set.begin() retorna o estado final dos
-     * autômatos. */
+    /* Cada quadro da pilha é um nó cujos filhos ainda não foram todos
+     * construídos; visited é a quantidade de filhos já empilhados, e q0
+     * é o novo estado inicial, se já numerado (veja rotated, acima).
+     * Os autômatos prontos ficam em built, como pares (inicial, final). */
+    struct Frame {
+        TreeIterator node;
+        int visited;
+        bool rotated;
+        int q0;
+    };
+    std::vector< Frame > stack{ {root, 0, false, -1} };
+    std::vector< std::pair< int, int > > built;
+
+    while( !stack.empty() ) {
+        Frame& frame = stack.back();
+        TreeIterator t = frame.node;
+
+        if( t->template is<Char>() || t->template is<Epsilon>() ) {
+            int q0 = counter++, f = counter++;
+            if( t->template is<Char>() ) {
+                Char c = t->operator Char();
+                edges.push_back({ q0, false, c, f });
+                alphabet.insert( c );
+            }
+            else
+                link( q0, f );
+            built.push_back({ q0, f });
+            stack.pop_back();
+            continue;
+        }
+
+        Operator op = t->template getAs<Operator>();
+        int arity = op == Operator::KleneeClosure   ||
+                    op == Operator::PositiveClosure ||
+                    op == Operator::Optional ? 1 : 2;
+        switch( op ) {
+            case Operator::KleneeClosure :
+            case Operator::PositiveClosure :
+            case Operator::Optional :
+            case Operator::SigmaClosure :
+            case Operator::Concatenation :
+            case Operator::VerticalBar :
+                break;
+            default:
+                throw token_error( "Extraneous operator found" );
+        }
+        if( frame.visited < arity ) {
+            if( frame.visited == 0 && frame.rotated &&
+                    op != Operator::Optional )
+                frame.q0 = counter++;
+            /* O opcional não cria estados: o seu estado inicial é o do
+             * filho, que herda, portanto, a rotação. */
+            bool rotated = frame.visited == 1 ||
+                           ( op == Operator::Optional && frame.rotated );
+            TreeIterator child = frame.visited == 0 ? t.leftChild()
+                                                    : t.rightChild();
+            frame.visited++;
+            stack.push_back({ child, 0, rotated, -1 }); // frame é inválido.
+            continue;
+        }
+        int q0 = frame.q0;
+        stack.pop_back();
+
+        std::pair< int, int > b = built.back();
+        if( arity == 2 )
+            built.pop_back();
+        std::pair< int, int > a = built.back();
+        built.pop_back();
+
+        if( op == Operator::Optional ) {
+            link( a.first, a.second );
+            built.push_back( a );
+            continue;
+        }
+
+        if( q0 == -1 )
+            q0 = counter++;
+        int f = counter++;
+        switch( op ) {
+            case Operator::KleneeClosure :
+                link( q0, f );
+                // fall through
+            case Operator::PositiveClosure :
+                link( q0, a.first );
+                link( a.second, a.first );
+                link( a.second, f );
+                break;
+            case Operator::SigmaClosure :
+                link( q0, a.first );
+                link( a.second, f );
+                link( a.second, b.first );
+                link( b.second, a.first );
+                break;
+            case Operator::Concatenation :
+                link( q0, a.first );
+                link( a.second, b.first );
+                link( b.second, f );
+                break;
+            default: // Operator::VerticalBar
+                link( q0, a.first );
+                link( q0, b.first );
+                link( a.second, f );
+                link( b.second, f );
+                break;
+        }
+        built.push_back({ q0, f });
+    }
+
+    /* Montagem do autômato: as transições são ordenadas pela origem e
+     * pelo símbolo, e cada conjunto de destinos é inserido de uma vez. */
+    NFAe< int, Char > r;
+    for( int q = 0; q < counter; ++q )
+        r.states.insert( r.states.end(), q );
+    r.alphabet = alphabet;
+    r.initialState = built.back().first;
+    r.finalStates = { built.back().second };
+
+    auto key = []( const Edge& e ) {
+        return std::make_tuple( e.from, e.isEpsilon, e.symbol );
+    };
+    std::sort( edges.begin(), edges.end(),
+        [&]( const Edge& x, const Edge& y ) { return key( x ) < key( y ); } );
+    for( std::size_t i = 0; i < edges.size(); ) {
+        std::size_t j = i;
+        std::set< int > targets;
+        for( ; j < edges.size() && key( edges[j] ) == key( edges[i] ); ++j )
+            targets.insert( edges[j].to );
+        if( edges[i].isEpsilon )
+            r.delta.insert( {edges[i].from, epsilon}, targets );
+        else
+            r.delta.insert( {edges[i].from, edges[i].symbol}, targets );
+        i = j;
+    }
+    return r;
 }
 
 #endif // THOMPSON_H
@@ -62,4 +62,53 @@ enum class Parentheses {
 template< typename Char >
 using TokenVector = std::vector<Either<Char, Epsilon, Operator, Parentheses> >;
 
+/* Tipos dos tokens, sem os valores. A concatenação nunca é lida da
+ * expressão, pois é implícita (os pontos são ignorados). */
+enum class TokenType {
+    Symbol, Epsilon, KleneeClosure, PositiveClosure, Optional, SigmaClosure,
+    Concatenation, VerticalBar, LeftParentheses, RightParentheses
+};
+
+/* Lê o próximo token da expressão delimitada por [i, end), segundo as
+ * regras de tokenize (regex/parsing.h), e avança i para depois dele.
+ * type recebe o tipo do token, e symbol aponta para o caractere que o
+ * originou (no caso de um símbolo precedido de contrabarra, o próprio
+ * símbolo). Retorna false caso não haja mais tokens.
+ *
+ * Esta é a única tabela de caracteres de controle; ela é constexpr
+ * para que regex/static.h também possa usá-la. */
+template< typename ForwardIterator >
+constexpr bool readToken( ForwardIterator& i, ForwardIterator end,
+                          TokenType& type, ForwardIterator& symbol );
+
+// Implementação
+template< typename ForwardIterator >
+constexpr bool readToken( ForwardIterator& i, ForwardIterator end,
+                          TokenType& type, ForwardIterator& symbol )
+{
+    for( ; i != end; ++i ) {
+        type = TokenType::Symbol;
+        switch( char(*i) ) {
+            case ':' : type = TokenType::SigmaClosure;     break;
+            case '*' : type = TokenType::KleneeClosure;    break;
+            case '+' : type = TokenType::PositiveClosure;  break;
+            case '?' : type = TokenType::Optional;         break;
+            case '|' : type = TokenType::VerticalBar;      break;
+            case '(' : type = TokenType::LeftParentheses;  break;
+            case ')' : type = TokenType::RightParentheses; break;
+            case '&' : type = TokenType::Epsilon;          break;
+            case '.' : /* pontos são ignorados */       continue;
+            case '\\':
+                if( ++i == end ) // Contrabarra terminal é ignorada.
+                    return false;
+                break;
+            default  :                                     break;
+        }
+        symbol = i;
+        ++i;
+        return true;
+    }
+    return false;
+}
+
 #endif // TOKENS_H
@@ -0,0 +1,59 @@
+/* alphabetClasses.test.cpp
+ * Teste de unidade para as funções de automaton/alphabetClasses.h.
+ */
+#include "automaton/alphabetClasses.h"
+
+#include <string>
+#include <vector>
+#include "algorithm/tuple_iterator.h"
+#include "test/lib/test.h"
+
+DECLARE_TEST( AlphabetClassesTest ) {
+    bool b = true;
+    /* b e c são indistinguíveis; d é indefinido em todos os estados,
+     * mas faz parte do alfabeto. */
+    DFA< int, char > dfa = { {0, 1, 2},
+                             {'a', 'b', 'c', 'd'},
+                             { {{0, 'a'}, 1}, {{0, 'b'}, 0}, {{0, 'c'}, 0},
+                               {{1, 'a'}, 1}, {{1, 'b'}, 2}, {{1, 'c'}, 2},
+                               {{2, 'a'}, 1}, {{2, 'b'}, 0}, {{2, 'c'}, 0}
+                             },
+                             0,
+                             {2}
+    };
+    SymbolClasses< char > classes = symbolClasses( dfa );
+    b &= Test::TEST_EQUALS( (int) classes.size(), 3 );
+    b &= Test::TEST_EQUALS( classes.classOf['b'], classes.classOf['c'] );
+    b &= Test::TEST_EQUALS( classes.classOf['a'] == classes.classOf['b'],
+                            false );
+    b &= Test::TEST_EQUALS( classes.representatives[1], 'b' );
+
+    DFA< int, int > compressed = compressAlphabet( dfa, classes );
+    b &= Test::TEST_EQUALS( (int) compressed.alphabet.size(), 3 );
+    b &= Test::TEST_EQUALS( compressed.delta({1, 1}), 2 );
+    b &= Test::TEST_EQUALS( compressed.delta.onDomain({1, 2}), false );
+
+    DFA< int, char > expanded = expandAlphabet( compressed, classes );
+    ByteClassDFA< char > table( dfa );
+    b &= Test::TEST_EQUALS( (int) table.classes(), 4 );
+    for( std::size_t n = 0; n < 5; ++n )
+        for( const std::vector<char>& w : tuple_range( dfa.alphabet, n ) ) {
+            bool expected = dfa.accepts( w.begin(), w.end() );
+            b &= Test::TEST_EQUALS( expanded.accepts( w.begin(), w.end() ),
+                                    expected );
+            b &= Test::TEST_EQUALS( table.accepts( w.begin(), w.end() ),
+                                    expected );
+        }
+    std::string s = "abz";
+    b &= Test::TEST_EQUALS( table.accepts( s.begin(), s.end() ), false );
+
+    NFAe< int, char > nfae;
+    nfae.states = {0, 1};
+    nfae.alphabet = {'x', 'y'};
+    nfae.addTransition( 0, 'x', 1 );
+    nfae.addTransition( 0, 'y', 1 );
+    nfae.addTransition( 1, epsilon, 0 );
+    b &= Test::TEST_EQUALS( (int) symbolClasses( nfae ).size(), 1 );
+
+    return b;
+}
@@ -0,0 +1,65 @@
+/* antichains.test.cpp
+ * Teste de unidade para automaton/antichains.h.
+ */
+#include "automaton/antichains.h"
+
+#include <string>
+#include <vector>
+#include "conversion.h"
+#include "test/lib/automata.h"
+#include "test/lib/test.h"
+
+DECLARE_TEST( AntichainsTest ) {
+    bool b = true;
+    std::vector< char > word;
+    auto abb = automaton( "(a|b)*abb" );
+    auto endsInB = automaton( "(a|b)*b" );
+    b &= Test::TEST_EQUALS( included( abb, endsInB, word ), true );
+    b &= Test::TEST_EQUALS( word.empty(), true );
+    b &= Test::TEST_EQUALS( included( endsInB, abb, word ), false );
+    b &= Test::TEST_EQUALS( accepts( endsInB, word ), true );
+    b &= Test::TEST_EQUALS( accepts( abb, word ), false );
+
+    // Símbolos fora do alfabeto do segundo autômato são rejeitados.
+    b &= Test::TEST_EQUALS( included( automaton( "a*c" ), automaton( "a*" ),
+                                      word ), false );
+    b &= Test::TEST_EQUALS( word == std::vector<char>({'c'}), true );
+
+    // Versões sem transições-épsilon.
+    b &= Test::TEST_EQUALS( included( toNFA( abb ), toNFA( endsInB ) ), true );
+    b &= Test::TEST_EQUALS( included( toNFA( endsInB ), toNFA( abb ) ), false );
+
+    b &= Test::TEST_EQUALS( universal( automaton( "(a|b)*" ) ), true );
+    b &= Test::TEST_EQUALS( universal( automaton( "(a|b)*a(a|b)*|b*" ) ),
+                            true );
+    auto endsInA = automaton( "(a|b)*a" );
+    b &= Test::TEST_EQUALS( universal( endsInA, word ), false );
+    b &= Test::TEST_EQUALS( accepts( endsInA, word ), false );
+
+    /* O autômato de subconjuntos de (a|b)*a(a|b)^n possui 2^(n+1)
+     * estados; com ele do lado direito, a busca percorre conjuntos de
+     * estados deste autômato, mas a anticadeia permanece pequena. */
+    const int n = 24;
+    auto hard = automaton( family( "(a|b)*a", "(a|b)", n ) );
+    auto abThenAny = automaton( family( "(a|b)*ab", "(a|b)", n - 1 ) );
+    auto same = automaton( family( "(b|a)*a", "(b|a)", n ) );
+    auto bThenAny = automaton( family( "(a|b)*b", "(a|b)", n ) );
+    b &= Test::TEST_EQUALS( included( abThenAny, hard, word ), true );
+    b &= Test::TEST_EQUALS( word.empty(), true );
+    b &= Test::TEST_EQUALS( included( same, hard ), true );
+    b &= Test::TEST_EQUALS( included( bThenAny, hard, word ), false );
+    b &= Test::TEST_EQUALS( (int) word.size(), n + 1 );
+    b &= Test::TEST_EQUALS( accepts( bThenAny, word ), true );
+    b &= Test::TEST_EQUALS( accepts( hard, word ), false );
+
+    /* A união das duas famílias rejeita apenas as palavras de tamanho
+     * até n, que não possuem a (n+1)-ésima posição a partir do fim. */
+    std::string either = family( "(a|b)*a", "(a|b)", n ) + "|" +
+                         family( "(a|b)*b", "(a|b)", n );
+    auto both = automaton( either );
+    b &= Test::TEST_EQUALS( universal( both, word ), false );
+    b &= Test::TEST_EQUALS( (int) word.size() <= n, true );
+    b &= Test::TEST_EQUALS( accepts( both, word ), false );
+
+    return b;
+}
@@ -3,6 +3,7 @@
  */
 #include "automaton/decisionProcedures.h"
 
+#include <vector>
 #include "test/lib/test.h"
 
 DECLARE_TEST( AutomatonDecisionProceduresTest ) {
@@ -89,5 +90,44 @@ DECLARE_TEST( AutomatonDecisionProceduresTest ) {
     b &= Test::TEST_EQUALS( empty( ambIb ), false );
     b &= Test::TEST_EQUALS( finite( ambIb ), false );
     b &= Test::TEST_EQUALS( infinite( ambIb ), true );
+
+    // As palavras encontradas são as menores que comprovam a resposta.
+    std::vector< char > word;
+    b &= Test::TEST_EQUALS( included( ambIb, amb, word ), false );
+    b &= Test::TEST_EQUALS( word == std::vector<char>({'b'}), true );
+    b &= Test::TEST_EQUALS( equivalent( axb, amb, word ), false );
+    b &= Test::TEST_EQUALS( word == std::vector<char>({'b'}), true );
+    b &= Test::TEST_EQUALS( disjoint( bxa, a, word ), false );
+    b &= Test::TEST_EQUALS( word == std::vector<char>({'a'}), true );
+    b &= Test::TEST_EQUALS( empty( bma, word ), false );
+    b &= Test::TEST_EQUALS( word == std::vector<char>({'b', 'a'}), true );
+    b &= Test::TEST_EQUALS( included( amb, axb, word ), true );
+    b &= Test::TEST_EQUALS( word.empty(), true );
+    b &= Test::TEST_EQUALS( empty( n, word ), true );
+    b &= Test::TEST_EQUALS( word.empty(), true );
+
+    // Símbolos fora do alfabeto de um dos autômatos levam à rejeição.
+    b &= Test::TEST_EQUALS( included( bma, a, word ), false );
+    b &= Test::TEST_EQUALS( word == std::vector<char>({'b', 'a'}), true );
+
+    /* Contadores módulo 6 e 7 com todos os estados finais aceitam a*,
+     * embora o produto alcance 42 pares. Com o estado 4 não final, a
+     * menor palavra que os distingue é aaaa. */
+    DFA< int, char > mod6, mod7;
+    for( DFA< int, char > * dfa : { &mod6, &mod7 } ) {
+        int m = dfa == &mod6 ? 6 : 7;
+        dfa->alphabet = {'a'};
+        for( int q = 0; q < m; ++q ) {
+            dfa->states.insert( q );
+            dfa->finalStates.insert( q );
+            dfa->delta.insert( {q, 'a'}, (q + 1) % m );
+        }
+        dfa->initialState = 0;
+    }
+    b &= Test::TEST_EQUALS( equivalent( mod6, mod7, word ), true );
+    b &= Test::TEST_EQUALS( word.empty(), true );
+    mod7.finalStates.erase( 4 );
+    b &= Test::TEST_EQUALS( equivalent( mod6, mod7, word ), false );
+    b &= Test::TEST_EQUALS( word == std::vector<char>( 4, 'a' ), true );
     return b;
 }
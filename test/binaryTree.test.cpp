@@ -0,0 +1,91 @@
+/* binaryTree.test.cpp
+ * Teste de unidade para a remoção de nodos e a compactação de
+ * utility/binaryTree.h.
+ */
+#include "utility/binaryTree.h"
+
+#include <vector>
+#include "algorithm/trees.h"
+#include "test/lib/test.h"
+
+namespace {
+    // Valores da árvore, em pré-ordem, seguindo apenas os filhos de fato.
+    std::vector< int > preorder( const BinaryTree< int >& tree ) {
+        std::vector< int > values;
+        std::vector< BinaryTree< int >::const_iterator > stack( 1, tree.root() );
+        while( !stack.empty() ) {
+            auto it = stack.back();
+            stack.pop_back();
+            values.push_back( *it );
+            if( it.rightChild() && it.rightChild().parent() == it )
+                stack.push_back( it.rightChild() );
+            if( it.leftChild() )
+                stack.push_back( it.leftChild() );
+        }
+        return values;
+    }
+} // anonymous namespace
+
+DECLARE_TEST( BinaryTreeTest ) {
+    bool b = true;
+    /*     1
+     *    / \
+     *   2   3
+     *  / \
+     * 4   5    */
+    BinaryTree< int > tree;
+    auto root = tree.root();
+    *root = 1;
+    root.makeLeftChild();
+    root.makeRightChild();
+    *root.rightChild() = 3;
+    auto two = root.leftChild();
+    *two = 2;
+    two.makeLeftChild();
+    two.makeRightChild();
+    *two.leftChild() = 4;
+    *two.rightChild() = 5;
+    b &= Test::TEST_EQUALS( (int) tree.size(), 5 );
+
+    // A remoção libera os espaços, que são reaproveitados em seguida.
+    two.destroyLeftSubtree();
+    root.destroyRightSubtree();
+    b &= Test::TEST_EQUALS( (int) tree.size(), 3 );
+    b &= Test::TEST_EQUALS( (int) tree.slots(), 5 );
+    two.makeLeftChild();
+    *two.leftChild() = 6;
+    b &= Test::TEST_EQUALS( (int) tree.slots(), 5 );
+
+    // Após as ascenções, os pais dos nodos movidos continuam corretos.
+    two.rightChild().leftAscent();
+    two.rightChild().rightAscent();
+    b &= Test::TEST_EQUALS( (int) tree.slots(), 6 );
+    auto moved = two.rightChild().leftChild();
+    b &= Test::TEST_EQUALS( moved.rightChild().parent() == moved, true );
+
+    /* A sub-árvore da direita de 2 passou a ser 5 -> 5 -> 5, à esquerda e
+     * depois à direita; ao colapsar, um dos nodos é liberado. */
+    two.rightChild().collapseLeft();
+    b &= Test::TEST_EQUALS( (int) tree.size(), 5 );
+    b &= Test::TEST_EQUALS( tree.liveRatio() < 1, true );
+    std::vector< int > before = preorder( tree );
+
+    // A compactação mantém a árvore e ordena os nodos em pré-ordem.
+    tree.compact();
+    b &= Test::TEST_EQUALS( (int) tree.slots(), 5 );
+    b &= Test::TEST_EQUALS( tree.liveRatio() == 1, true );
+    b &= Test::TEST_EQUALS( preorder( tree ) == before, true );
+    for( std::size_t i = 0; i < tree.raw().size(); ++i )
+        b &= Test::TEST_EQUALS( tree.raw()[i].data == before[i], true );
+
+    // As costuras são preservadas.
+    addRightThreads( tree.root() );
+    std::vector< int > threads;
+    for( const auto& node : tree.raw() )
+        threads.push_back( node.rightChild );
+    tree.compact();
+    for( std::size_t i = 0; i < tree.raw().size(); ++i )
+        b &= Test::TEST_EQUALS( tree.raw()[i].rightChild, threads[i] );
+
+    return b;
+}
@@ -0,0 +1,43 @@
+/* bisimulation.test.cpp
+ * Teste de unidade para automaton/bisimulation.h.
+ */
+#include "automaton/bisimulation.h"
+
+#include <string>
+#include <vector>
+#include "conversion.h"
+#include "test/lib/automata.h"
+#include "test/lib/test.h"
+
+DECLARE_TEST( BisimulationTest ) {
+    bool b = true;
+    std::vector< char > word;
+    b &= Test::TEST_EQUALS( equivalent( automaton( "(a|b)*" ),
+                                        automaton( "(a*b*)*" ), word ), true );
+    b &= Test::TEST_EQUALS( word.empty(), true );
+    b &= Test::TEST_EQUALS( equivalent( automaton( "a(ba)*" ),
+                                        automaton( "(ab)*a" ) ), true );
+    b &= Test::TEST_EQUALS( equivalent( toNFA( automaton( "a:b" ) ),
+                                        toNFA( automaton( "a(ba)*" ) ) ),
+                            true );
+
+    auto x = automaton( "(a|b)*abb" ), y = automaton( "(a|b)*b" );
+    b &= Test::TEST_EQUALS( equivalent( x, y, word ), false );
+    b &= Test::TEST_EQUALS( accepts( x, word ) != accepts( y, word ), true );
+    b &= Test::TEST_EQUALS( equivalent( automaton( "a*" ), automaton( "a+" ),
+                                        word ), false );
+    b &= Test::TEST_EQUALS( word.empty(), true );
+
+    /* O autômato de subconjuntos de (a|b)*a(a|b)^n possui 2^(n+1)
+     * estados; a busca não o constrói. */
+    std::string r1 = family( "(a|b)*a", "(a|b)", 20 );
+    std::string r2 = family( "(b|a)*a", "(b|a)", 20 );
+    b &= Test::TEST_EQUALS( equivalent( automaton( r1 ), automaton( r2 ) ),
+                            true );
+    b &= Test::TEST_EQUALS( equivalent( automaton( r1 ),
+                                        automaton( r2 + "(a|b)" ), word ),
+                            false );
+    b &= Test::TEST_EQUALS( (int) word.size(), 21 );
+
+    return b;
+}
@@ -0,0 +1,45 @@
+/* bitParallel.test.cpp
+ * Teste de unidade para a classe BitParallelNFA, de regex/bitParallel.h.
+ */
+#include "regex/bitParallel.h"
+
+#include <string>
+#include <vector>
+#include "algorithm/tuple_iterator.h"
+#include "regex/deSimone.h"
+#include "regex/parsing.h"
+#include "test/lib/test.h"
+
+DECLARE_TEST( BitParallelNFATest ) {
+    bool b = true;
+    std::vector< std::string > regexes = { "(a|b)*abb", "ab*c:d", "&",
+        "(a|&)(b|&)", "(ab|a)*:b?", "(a*b*)*c?" };
+    std::set< char > alphabet = { 'a', 'b', 'c', 'd' };
+
+    for( const std::string& regex : regexes ) {
+        DFA< int, char > dfa = deSimone( parse( regex ) );
+        BitParallelNFA< char > nfa( parse( regex ) );
+        BitParallelNFA< char, 2 > wide( parse( regex ) );
+        for( std::size_t n = 0; n < 6; ++n )
+            for( const std::vector<char>& w : tuple_range( alphabet, n ) ) {
+                bool expected = dfa.accepts( w.begin(), w.end() );
+                b &= Test::TEST_EQUALS( nfa.accepts( w.begin(), w.end() ),
+                                        expected );
+                b &= Test::TEST_EQUALS( wide.accepts( w.begin(), w.end() ),
+                                        expected );
+            }
+    }
+
+    BitParallelNFA< char > abb( parse( std::string( "(a|b)*abb" ) ) );
+    b &= Test::TEST_EQUALS( (int) abb.positions(), 5 );
+
+    std::string long_( 64, 'a' );
+    bool thrown = true;
+    EXPECT_THROW( BitParallelNFA< char >{ parse( long_ ) },
+                  std::length_error, thrown );
+    b &= thrown;
+    BitParallelNFA< char, 2 > wide( parse( long_ ) );
+    b &= Test::TEST_EQUALS( wide.accepts( long_.begin(), long_.end() ), true );
+
+    return b;
+}
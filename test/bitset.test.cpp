@@ -0,0 +1,56 @@
+/* bitset.test.cpp
+ * Teste de unidade para utility/bitset.h.
+ */
+#include "utility/bitset.h"
+
+#include <unordered_set>
+#include <vector>
+#include "test/lib/test.h"
+
+DECLARE_TEST( BitsetTest ) {
+    bool b = true;
+    // 130 bits: três palavras, a última parcialmente usada.
+    Bitset x( 130 ), y( 130 );
+    b &= Test::TEST_EQUALS( x.none(), true );
+    x.set( 0 );
+    x.set( 64 );
+    x.set( 129 );
+    b &= Test::TEST_EQUALS( x.test( 64 ), true );
+    b &= Test::TEST_EQUALS( x.test( 63 ), false );
+    b &= Test::TEST_EQUALS( (int) x.count(), 3 );
+    std::vector< int > elements;
+    x.forEach( [&]( std::size_t i ) { elements.push_back( i ); } );
+    b &= Test::TEST_EQUALS( elements == std::vector<int>({0, 64, 129}), true );
+
+    // Igualdade e hash.
+    y.set( 129 );
+    y.set( 64 );
+    b &= Test::TEST_EQUALS( x == y, false );
+    y.set( 0 );
+    b &= Test::TEST_EQUALS( x == y, true );
+    b &= Test::TEST_EQUALS( x.hash() == y.hash(), true );
+    std::unordered_set< Bitset, BitsetHash > set = { x, y };
+    b &= Test::TEST_EQUALS( (int) set.size(), 1 );
+    y.reset( 0 );
+    b &= Test::TEST_EQUALS( x != y, true );
+    b &= Test::TEST_EQUALS( x.hash() == y.hash(), false );
+
+    // Inclusão, interseção e as operações de conjunto.
+    b &= Test::TEST_EQUALS( y.isSubsetOf( x ), true );
+    b &= Test::TEST_EQUALS( x.isSubsetOf( y ), false );
+    b &= Test::TEST_EQUALS( x.isSubsetOf( x ), true );
+    Bitset z( 130 );
+    z.set( 1 );
+    b &= Test::TEST_EQUALS( z.intersects( x ), false );
+    b &= Test::TEST_EQUALS( Bitset( 130 ).isSubsetOf( z ), true );
+    z |= y;
+    b &= Test::TEST_EQUALS( z.intersects( x ), true );
+    b &= Test::TEST_EQUALS( (int) z.count(), 3 );
+    z &= x;
+    b &= Test::TEST_EQUALS( z == y, true );
+    z.clear();
+    b &= Test::TEST_EQUALS( z.none(), true );
+    b &= Test::TEST_EQUALS( (int) z.size(), 130 );
+
+    return b;
+}
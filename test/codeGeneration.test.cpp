@@ -0,0 +1,96 @@
+/* codeGeneration.test.cpp
+ * Teste de unidade para generateMatcher, de automaton/codeGeneration.h.
+ */
+#include "automaton/codeGeneration.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "test/lib/test.h"
+#include "test/lib/throw.h"
+
+DECLARE_TEST( CodeGenerationTest ) {
+    bool b = true;
+
+    /* O estado 2 é morto; as transições para ele encerram a leitura.
+     * Os intervalos 'a'-'e' viram comparações, e os símbolos isolados,
+     * rótulos do switch. */
+    DFA< int, char > dfa;
+    dfa.states = {0, 1, 2};
+    dfa.alphabet = {'0', '#', 'a', 'b', 'c', 'd', 'e', 'x', 'y'};
+    for( char c : {'a', 'b', 'c', 'd', 'e', 'x', 'y'} )
+        dfa.delta.insert( {0, c}, 1 );
+    dfa.delta.insert( {0, '#'}, 2 );
+    for( char c : {'a', 'b', 'c', 'd', 'e'} ) {
+        dfa.delta.insert( {1, c}, 1 );
+        dfa.delta.insert( {2, c}, 2 );
+    }
+    dfa.delta.insert( {1, '0'}, 0 );
+    dfa.initialState = 0;
+    dfa.finalStates = {1};
+
+    std::ostringstream out;
+    generateMatcher( dfa, "matcher", out );
+    std::string expected =
+        "inline bool matcher( const char * p, const char * end ) {\n"
+        "    unsigned c;\n"
+        "s0:\n"
+        "    if( p == end )\n"
+        "        return false;\n"
+        "    c = (unsigned char) *p++;\n"
+        "    switch( c ) {\n"
+        "        case 'x': case 'y': goto s1;\n"
+        "    }\n"
+        "    if( c >= 'a' && c <= 'e' )\n"
+        "        goto s1;\n"
+        "    return false;\n"
+        "s1:\n"
+        "    if( p == end )\n"
+        "        return true;\n"
+        "    c = (unsigned char) *p++;\n"
+        "    switch( c ) {\n"
+        "        case '0': goto s0;\n"
+        "    }\n"
+        "    if( c >= 'a' && c <= 'e' )\n"
+        "        goto s1;\n"
+        "    return false;\n"
+        "}\n";
+    b &= Test::TEST_EQUALS( out.str() == expected, true );
+    b &= Test::TEST_EQUALS( out.str().find( "s2" ) == std::string::npos,
+                            true );
+
+    // Intervalos que começam em 0 ou terminam em 255.
+    DFA< int, char > any;
+    any.states = {0, 1};
+    for( int c = -128; c < 128; ++c ) {
+        any.alphabet.insert( char( c ) );
+        any.delta.insert( {0, char( c )}, 1 );
+    }
+    any.initialState = 0;
+    any.finalStates = {1};
+    out.str( "" );
+    generateMatcher( any, "any", out );
+    b &= Test::TEST_EQUALS( out.str().find( "    goto s1;\n" ) !=
+                            std::string::npos, true );
+    b &= Test::TEST_EQUALS( out.str().find( "switch" ) == std::string::npos,
+                            true );
+    b &= Test::TEST_EQUALS( out.str().find( "s1:\n    return p == end;\n" ) !=
+                            std::string::npos, true );
+
+    // Linguagem vazia: o estado inicial não alcança nenhum estado final.
+    DFA< int, char > empty;
+    empty.states = {0};
+    empty.initialState = 0;
+    out.str( "" );
+    generateMatcher( empty, "none", out );
+    b &= Test::TEST_EQUALS( out.str() ==
+        "inline bool none( const char * p, const char * end ) {\n"
+        "    (void) p;\n    (void) end;\n    return false;\n}\n", true );
+
+    DFA< int, char > sparse;
+    sparse.states = {1, 5};
+    sparse.initialState = 1;
+    EXPECT_THROW( generateMatcher( sparse, "f", out ), std::domain_error, b );
+
+    return b;
+}
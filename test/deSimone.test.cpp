@@ -0,0 +1,51 @@
+/* deSimone.test.cpp
+ * Teste de unidade para regex/deSimone.h.
+ */
+#include "regex/deSimone.h"
+
+#include <string>
+#include <vector>
+#include "regex/parsing.h"
+#include "test/lib/test.h"
+
+DECLARE_TEST( DeSimoneTest ) {
+    bool b = true;
+    /* (a|b)c*: as posições são a = 0, b = 1 e c = 2; o bit 3 é o fim
+     * da expressão. */
+    auto tree = parse( std::string( "(a|b)c*" ) );
+    removeSigmaClosure( tree );
+    removeEpsilon( tree );
+    addRightThreads( tree.root() );
+    Composition< char > composition = buildComposition( tree.root() );
+    b &= Test::TEST_EQUALS( composition.symbols ==
+                            std::vector<char>({'a', 'b', 'c'}), true );
+    Bitset expected( 4 );
+    expected.set( 0 );
+    expected.set( 1 );
+    b &= Test::TEST_EQUALS( composition.initial == expected, true );
+    expected.clear();
+    expected.set( 2 );
+    expected.set( 3 );
+    for( const Bitset& follow : composition.follow )
+        b &= Test::TEST_EQUALS( follow == expected, true );
+
+    // O autômato já é compacto, e o estado inicial é o 0.
+    DFA< int, char > dfa = buildAutomaton( composition );
+    b &= Test::TEST_EQUALS( (int) dfa.states.size(), 2 );
+    b &= Test::TEST_EQUALS( dfa.initialState, 0 );
+    b &= Test::TEST_EQUALS( (int) dfa.finalStates.count( 1 ), 1 );
+    b &= Test::TEST_EQUALS( dfa.delta({0, 'b'}), 1 );
+    b &= Test::TEST_EQUALS( dfa.delta({1, 'c'}), 1 );
+
+    // a:b = a(ba)*; a palavra vazia é tratada à parte.
+    dfa = deSimone( parse( std::string( "a:b" ) ) );
+    std::string words[] = { "a", "aba", "ababa", "", "ab", "b", "abba" };
+    for( int i = 0; i < 7; ++i )
+        b &= Test::TEST_EQUALS( dfa.accepts( words[i].begin(), words[i].end() ),
+                                i < 3 );
+    dfa = deSimone( parse( std::string( "&*" ) ) );
+    b &= Test::TEST_EQUALS( (int) dfa.states.size(), 1 );
+    b &= Test::TEST_EQUALS( (int) dfa.finalStates.count( 0 ), 1 );
+
+    return b;
+}
@@ -0,0 +1,42 @@
+/* dense.test.cpp
+ * Teste de unidade para a classe DenseDFA, de automaton/dense.h.
+ */
+#include "automaton/dense.h"
+
+#include <string>
+#include <vector>
+#include "algorithm/tuple_iterator.h"
+#include "test/lib/test.h"
+
+DECLARE_TEST( DenseDFATest ) {
+    bool b = true;
+    DFA< int, char > amb = { {0, 1, 2},
+                             {'a', 'b'},
+                             { {{0, 'a'}, 1},
+                               {{1, 'a'}, 1},
+                               {{1, 'b'}, 2}
+                             },
+                             0,
+                             {2}
+    }; // a+b
+    DenseDFA< char > dense( amb );
+
+    b &= Test::TEST_EQUALS( (int) dense.size(), 4 );
+    for( std::size_t n = 0; n < 6; ++n )
+        for( const std::vector<char>& w : tuple_range( amb.alphabet, n ) )
+            b &= Test::TEST_EQUALS( dense.accepts( w.begin(), w.end() ),
+                                    amb.accepts( w.begin(), w.end() ) );
+
+    std::string s = "aacb";
+    b &= Test::TEST_EQUALS( dense.accepts( s.begin(), s.end() ), false );
+    b &= Test::TEST_EQUALS( dense.next( dense.initialState(), 'b' ) ==
+                            DenseDFA< char >::dead, true );
+
+    DFA< int, char > notCompact = amb;
+    notCompact.states.insert( 5 );
+    bool thrown = true;
+    EXPECT_THROW( DenseDFA< char >{ notCompact }, std::domain_error, thrown );
+    b &= thrown;
+
+    return b;
+}
@@ -0,0 +1,51 @@
+/* derivatives.test.cpp
+ * Teste de unidade para regex/derivatives.h.
+ */
+#include "regex/derivatives.h"
+
+#include <string>
+#include <vector>
+#include "automaton/decisionProcedures.h"
+#include "regex/deSimone.h"
+#include "regex/parsing.h"
+#include "test/lib/test.h"
+
+DECLARE_TEST( DerivativesTest ) {
+    bool b = true;
+    std::vector< std::string > regexes = { "(a|b)*abb", "a:b", "(ab|a)*b?",
+        "a+b*|c", "&", "(a|&)(b|&)", "((a*)*|b)*", "(a|b)*a(a|b)(a|b)" };
+    std::vector< std::string > words = { "", "a", "b", "ab", "abb", "aabb",
+        "aba", "abab", "ba", "bba", "c", "abc", "aaab" };
+    for( const std::string& regex : regexes ) {
+        DFA< int, char > dfa = brzozowski( parse( regex ) );
+        DFA< int, char > expected = deSimone( parse( regex ) );
+        b &= Test::TEST_EQUALS( equivalent( dfa, expected ), true );
+        b &= Test::TEST_EQUALS( dfa.initialState, 0 );
+
+        DerivativeAutomaton< char > lazy( parse( regex ) );
+        for( const std::string& w : words )
+            b &= Test::TEST_EQUALS( lazy.accepts( w.begin(), w.end() ),
+                                    expected.accepts( w.begin(), w.end() ) );
+    }
+
+    /* Com a união tratada como conjunto, (b|a)* e (a|b)* são a mesma
+     * expressão, que é a sua própria derivada por a e por b. */
+    DFA< int, char > dfa = brzozowski(
+            parse( std::string( "(b|a)*|(a|b)*" ) ) );
+    b &= Test::TEST_EQUALS( (int) dfa.states.size(), 1 );
+
+    // A construção sob demanda calcula apenas as derivadas necessárias.
+    DerivativeAutomaton< char > lazy(
+            parse( std::string( "(a|b)*a(a|b)(a|b)(a|b)" ) ) );
+    std::size_t before = lazy.expressions();
+    std::string w = "aaaa";
+    b &= Test::TEST_EQUALS( lazy.accepts( w.begin(), w.end() ), true );
+    std::size_t after = lazy.expressions();
+    b &= Test::TEST_EQUALS( lazy.accepts( w.begin(), w.end() ), true );
+    b &= Test::TEST_EQUALS( (int) lazy.expressions(), (int) after );
+    lazy.toDFA();
+    b &= Test::TEST_EQUALS( before < after, true );
+    b &= Test::TEST_EQUALS( after < lazy.expressions(), true );
+
+    return b;
+}
@@ -0,0 +1,44 @@
+/* epsilonClosure.test.cpp
+ * Teste de unidade para automaton/epsilonClosure.h e para a remoção
+ * de transições-épsilon em conversion.h.
+ */
+#include "automaton/epsilonClosure.h"
+#include "conversion.h"
+
+#include "test/lib/test.h"
+
+DECLARE_TEST( EpsilonClosureTest ) {
+    bool b = true;
+    /* 0, 1 e 2 formam um ciclo de transições-épsilon, que alcança 3;
+     * apenas 3 possui transição por símbolo. */
+    NFAe< int, char > nfae;
+    nfae.states = {0, 1, 2, 3, 4};
+    nfae.alphabet = {'a'};
+    nfae.addTransition( 0, epsilon, 1 );
+    nfae.addTransition( 1, epsilon, 2 );
+    nfae.addTransition( 2, epsilon, 0 );
+    nfae.addTransition( 2, epsilon, 3 );
+    nfae.addTransition( 3, 'a', 4 );
+    nfae.initialState = 1;
+    nfae.finalStates = {3};
+
+    EpsilonClosureTable< int > closure( nfae );
+    b &= Test::TEST_EQUALS( (int) closure.components(), 3 );
+    b &= Test::TEST_EQUALS( closure.component( 0 ) == closure.component( 2 ),
+                            true );
+    b &= Test::TEST_EQUALS( closure.component( 3 ) < closure.component( 0 ),
+                            true );
+    b &= Test::TEST_EQUALS( closure( 1 ) == std::vector<int>({0, 1, 2, 3}),
+                            true );
+    b &= Test::TEST_EQUALS( closure( 4 ) == std::vector<int>({4}), true );
+    b &= Test::TEST_EQUALS( closure( std::set<int>{3, 4} ) ==
+                            std::set<int>({3, 4}), true );
+
+    NFA< int, char > nfa = toNFA( nfae, closure );
+    b &= Test::TEST_EQUALS( nfa.delta({0, 'a'}) == std::set<int>({4}), true );
+    b &= Test::TEST_EQUALS( nfa.delta({4, 'a'}).empty(), true );
+    b &= Test::TEST_EQUALS( (int) nfa.finalStates.count( 1 ), 1 );
+    b &= Test::TEST_EQUALS( (int) nfa.finalStates.count( 0 ), 0 );
+
+    return b;
+}
@@ -0,0 +1,111 @@
+/* lazyDeterministic.test.cpp
+ * Teste de unidade para a classe LazyDFA, de automaton/lazyDeterministic.h.
+ */
+#include "automaton/lazyDeterministic.h"
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "conversion.h"
+#include "regex/parsing.h"
+#include "regex/thompson.h"
+#include "test/lib/test.h"
+#include "test/lib/throw.h"
+
+namespace {
+    /* Palavras pseudo-aleatórias sobre {a, b}, de tamanhos variados;
+     * a semente é fixa, para que o teste seja reprodutível. */
+    std::vector< std::string > randomWords( std::size_t count ) {
+        std::mt19937 generator( 7 );
+        std::uniform_int_distribution< int > size( 0, 64 ), symbol( 0, 1 );
+        std::vector< std::string > words;
+        for( std::size_t i = 0; i < count; ++i ) {
+            std::string w( size( generator ), 'a' );
+            for( char& c : w )
+                c = symbol( generator ) ? 'b' : 'a';
+            words.push_back( w );
+        }
+        return words;
+    }
+} // anonymous namespace
+
+DECLARE_TEST( LazyDFATest ) {
+    bool b = true;
+
+    /* O autômato de subconjuntos de (a|b)*a(a|b)^10 possui 2^11 estados;
+     * com uma cache de poucos estados, ela precisa ser esvaziada. */
+    std::string regex = "(a|b)*a";
+    for( int i = 0; i < 10; ++i )
+        regex += "(a|b)";
+    NFAe< int, char > nfae = thompson( parse( regex ) );
+    auto dfa = toDFA( nfae );
+
+    /* Cada estado ocupa, no mínimo, o subconjunto e o vetor de
+     * transições; assim, a cache nunca pode passar de bound estados. */
+    const std::size_t budget = 4096;
+    const std::size_t bound = budget /
+        ( sizeof(Bitset) + sizeof(std::vector<int>) );
+    LazyDFA< char > small( nfae, budget );
+    LazyDFA< char > large( nfae );
+
+    bool agrees = true, withinBudget = true;
+    for( const std::string& w : randomWords( 500 ) ) {
+        bool expected = dfa.accepts( w.begin(), w.end() );
+        agrees &= small.accepts( w.begin(), w.end() ) == expected;
+        agrees &= large.accepts( w.begin(), w.end() ) == expected;
+        withinBudget &= small.cachedStates() <= bound;
+    }
+    b &= Test::TEST_EQUALS( agrees, true );
+    b &= Test::TEST_EQUALS( withinBudget, true );
+    b &= Test::TEST_EQUALS( large.cachedStates() > bound, true );
+
+    const auto& s = small.statistics();
+    b &= Test::TEST_EQUALS( s.hits > 0, true );
+    b &= Test::TEST_EQUALS( s.misses > 0, true );
+    b &= Test::TEST_EQUALS( s.flushes > 0, true );
+    b &= Test::TEST_EQUALS( s.fallbacks > 0, true );
+
+    /* Com a cache grande, nada é esvaziado; como as transições já
+     * calculadas são reaproveitadas, os acertos superam as falhas. */
+    const auto& l = large.statistics();
+    b &= Test::TEST_EQUALS( (int) l.flushes, 0 );
+    b &= Test::TEST_EQUALS( (int) l.fallbacks, 0 );
+    b &= Test::TEST_EQUALS( l.misses >= large.cachedStates() - 1, true );
+    b &= Test::TEST_EQUALS( l.hits > l.misses, true );
+
+    /* Repetir a mesma palavra na cache grande produz apenas acertos. */
+    std::string w = "abbabaabab";
+    large.accepts( w.begin(), w.end() );
+    std::size_t misses = l.misses, hits = l.hits;
+    large.accepts( w.begin(), w.end() );
+    b &= Test::TEST_EQUALS( (int) (l.misses - misses), 0 );
+    b &= Test::TEST_EQUALS( (int) (l.hits - hits), (int) w.size() );
+
+    // Modo não-ancorado e scan, também com a cache pequena.
+    LazyDFA< char > unanchored( nfae, budget,
+                                LazyDFA< char >::Mode::Unanchored );
+    bool scans = true;
+    for( const std::string& w : randomWords( 100 ) ) {
+        std::vector< std::size_t > expected, found;
+        for( std::size_t i = 0; i <= w.size(); ++i )
+            if( dfa.accepts( w.begin(), w.begin() + i ) )
+                expected.push_back( i );
+        small.scan( w.begin(), w.end(), [&]( std::size_t i ) {
+            found.push_back( i );
+        });
+        scans &= found == expected;
+        scans &= unanchored.accepts( w.begin(), w.end() ) ==
+                 dfa.accepts( w.begin(), w.end() );
+    }
+    b &= Test::TEST_EQUALS( scans, true );
+    b &= Test::TEST_EQUALS( unanchored.cachedStates() <= bound, true );
+
+    // Estados que não formam o intervalo {0, ..., n-1}.
+    NFAe< int, char > sparse;
+    sparse.states = {1, 5};
+    sparse.initialState = 1;
+    EXPECT_THROW( LazyDFA< char >{ sparse }, std::domain_error, b );
+
+    return b;
+}
@@ -0,0 +1,80 @@
+/* lexer.test.cpp
+ * Teste de unidade para a classe Lexer, de regex/lexer.h.
+ */
+#include "regex/lexer.h"
+
+#include <string>
+#include <vector>
+#include "test/lib/countingIterator.h"
+#include "test/lib/test.h"
+
+DECLARE_TEST( LexerTest ) {
+    bool b = true;
+    enum { If, Identifier, Number, Space, Operator };
+    std::string letter = "(a|b|c|d|e|f|i|x|y|z)";
+    std::string digit = "(0|1|2|3|4|5|6|7|8|9)";
+    std::vector< Lexer< char >::Rule > rules = {
+        { letter + "(" + letter + "|" + digit + ")*", Identifier, 0 },
+        { "if", If, 1 },
+        { digit + "+", Number, 0 },
+        { "( |\n)+", Space, 0 },
+        { "=|==|<|<=", Operator, 0 },
+    };
+    Lexer< char > lexer( rules );
+
+    std::string text = "if iff==12 x<=if2";
+    auto tokens = lexer.tokenize( text.begin(), text.end() );
+    std::vector< int > ids, ends;
+    for( const auto& token : tokens ) {
+        ids.push_back( token.id );
+        ends.push_back( token.end );
+    }
+    std::vector< int > expectedIds = { If, Space, Identifier, Operator, Number,
+        Space, Identifier, Operator, Identifier };
+    std::vector< int > expectedEnds = { 2, 3, 6, 8, 10, 11, 12, 14, 17 };
+    b &= Test::TEST_EQUALS( ids == expectedIds, true );
+    b &= Test::TEST_EQUALS( ends == expectedEnds, true );
+    b &= Test::TEST_EQUALS( (int) tokens[0].begin, 0 );
+    b &= Test::TEST_EQUALS( (int) tokens[2].begin, 3 );
+
+    // Empate de prioridades: vence a primeira regra.
+    Lexer< char > tie({ { "ab", 7, 0 }, { "a(b|c)", 8, 0 } });
+    text = "abac";
+    tokens = tie.tokenize( text.begin(), text.end() );
+    b &= Test::TEST_EQUALS( (int) tokens.size(), 2 );
+    b &= Test::TEST_EQUALS( tokens[0].id, 7 );
+    b &= Test::TEST_EQUALS( tokens[1].id, 8 );
+
+    // Cada token tem seu próprio estado final no autômato mínimo.
+    Lexer< char > same({ { "a", 0, 0 }, { "b", 1, 0 } });
+    b &= Test::TEST_EQUALS( (int) same.states(), 4 );
+    Lexer< char > merged({ { "a", 0, 0 }, { "b", 0, 0 } });
+    b &= Test::TEST_EQUALS( (int) merged.states(), 3 );
+
+    /* Com as regras a e a*b, num texto só com a, cada token tem tamanho
+     * 1, mas o autômato só morre no fim do texto; ainda assim, a
+     * leitura não pode custar tempo quadrático. */
+    Lexer< char > munch({ { "a", 0, 0 }, { "a*b", 1, 0 } });
+    std::vector< char > as( 20000, 'a' );
+    std::size_t reads = 0;
+    tokens = munch.tokenize( CountingIterator( as.data(), &reads ),
+                             CountingIterator( as.data() + as.size(), &reads ) );
+    b &= Test::TEST_EQUALS( (int) tokens.size(), (int) as.size() );
+    b &= Test::TEST_EQUALS( (int) tokens.back().begin, (int) as.size() - 1 );
+    b &= Test::TEST_EQUALS( reads <= 8 * as.size(), true );
+    text = "aaab";
+    tokens = munch.tokenize( text.begin(), text.end() );
+    b &= Test::TEST_EQUALS( (int) tokens.size(), 1 );
+    b &= Test::TEST_EQUALS( tokens[0].id, 1 );
+
+    text = "if 1w";
+    EXPECT_THROW( lexer.tokenize( text.begin(), text.end() ),
+                  lexical_error, b );
+    try {
+        lexer.tokenize( text.begin(), text.end() );
+    } catch( lexical_error& e ) {
+        b &= Test::TEST_EQUALS( (int) e.index, 4 );
+    }
+
+    return b;
+}
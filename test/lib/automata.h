@@ -0,0 +1,38 @@
+/* automata.h
+ * Funções auxiliares para os testes e benchmarks que constroem
+ * autômatos a partir de expressões regulares.
+ */
+#ifndef AUTOMATA_H
+#define AUTOMATA_H
+
+#include <string>
+#include <vector>
+#include "automaton/lazyDeterministic.h"
+#include "automaton/nonDeterministicWithEpsilon.h"
+#include "regex/parsing.h"
+#include "regex/thompson.h"
+
+// NFAe da expressão regular passada, pela construção de Thompson.
+inline NFAe< int, char > automaton( const std::string& regex ) {
+    return thompson( parse( regex ) );
+}
+
+/* Decide se nfae aceita word. LazyDFA não constrói o autômato de
+ * subconjuntos inteiro, que é exponencial em famílias como as de
+ * family, abaixo. */
+inline bool accepts( const NFAe< int, char >& nfae,
+                     const std::vector< char >& word )
+{
+    return LazyDFA< char >( nfae ).accepts( word.begin(), word.end() );
+}
+
+/* prefix seguido de n cópias de step; por exemplo,
+ * family( "(a|b)*a", "(a|b)", n ) é a expressão (a|b)*a(a|b)^n. */
+inline std::string family( const char * prefix, const char * step, int n ) {
+    std::string s = prefix;
+    for( int i = 0; i < n; ++i )
+        s += step;
+    return s;
+}
+
+#endif // AUTOMATA_H
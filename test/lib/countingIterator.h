@@ -0,0 +1,54 @@
+/* countingIterator.h
+ * Iterador que conta as leituras, usado para verificar quantos símbolos
+ * um algoritmo lê da entrada.
+ */
+#ifndef COUNTING_ITERATOR_H
+#define COUNTING_ITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+
+/* Iterador sobre um vetor de caracteres que conta quantas vezes
+ * algum caractere foi lido. */
+class CountingIterator {
+    const char * p;
+    std::size_t * reads;
+
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef char value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const char * pointer;
+    typedef const char& reference;
+
+    CountingIterator( const char * p, std::size_t * reads ) :
+        p( p ), reads( reads )
+    {}
+
+    reference operator*() const {
+        ++*reads;
+        return *p;
+    }
+    CountingIterator& operator++() {
+        ++p;
+        return *this;
+    }
+    CountingIterator& operator--() {
+        --p;
+        return *this;
+    }
+    CountingIterator operator+( difference_type d ) const {
+        return CountingIterator( p + d, reads );
+    }
+    difference_type operator-( const CountingIterator& other ) const {
+        return p - other.p;
+    }
+    bool operator==( const CountingIterator& other ) const {
+        return p == other.p;
+    }
+    bool operator!=( const CountingIterator& other ) const {
+        return p != other.p;
+    }
+};
+
+#endif // COUNTING_ITERATOR_H
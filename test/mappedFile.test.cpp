@@ -0,0 +1,95 @@
+/* mappedFile.test.cpp
+ * Teste de unidade para a classe MappedFile, de utility/mappedFile.h,
+ * usada para carregar autômatos gravados por serialize.
+ */
+#include "utility/mappedFile.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "conversion.h"
+#include "algorithm/tuple_iterator.h"
+#include "automaton/compaction.h"
+#include "automaton/minimization.h"
+#include "automaton/serialization.h"
+#include "regex/parsing.h"
+#include "regex/thompson.h"
+#include "test/lib/test.h"
+#include "test/lib/throw.h"
+
+namespace {
+    /* Grava o conteúdo passado num arquivo temporário novo e retorna
+     * o seu nome. */
+    std::string temporaryFile( const std::string& contents ) {
+        char name[] = "/tmp/mappedFileTestXXXXXX";
+        int fd = mkstemp( name );
+        if( fd != -1 )
+            close( fd );
+        std::ofstream( name, std::ios::binary ) << contents;
+        return name;
+    }
+} // anonymous namespace
+
+DECLARE_TEST( MappedFileTest ) {
+    bool b = true;
+    std::string regex = "(a|b)*abb:c";
+    DFA< int, char > dfa = compact( minimize( toCompactDFA(
+                thompson( parse( regex ) ) ) ) );
+    NFA< int, char > nfa = compact( toNFA( thompson( parse( regex ) ) ) );
+
+    std::ostringstream dfaStream, nfaStream;
+    serialize( dfa, dfaStream );
+    serialize( nfa, nfaStream );
+    std::string dfaName = temporaryFile( dfaStream.str() );
+    std::string nfaName = temporaryFile( nfaStream.str() );
+
+    {
+        MappedFile dfaFile( dfaName ), nfaFile( nfaName );
+        b &= Test::TEST_EQUALS( (int) dfaFile.size(),
+                                (int) dfaStream.str().size() );
+        b &= Test::TEST_EQUALS( std::string( static_cast< const char * >(
+                        dfaFile.data() ), dfaFile.size() ) == dfaStream.str(),
+                                true );
+
+        MappedDFA< char > mappedDFA( dfaFile.data(), dfaFile.size() );
+        MappedNFA< char > mappedNFA( nfaFile.data(), nfaFile.size() );
+        b &= Test::TEST_EQUALS( (int) mappedDFA.size(),
+                                (int) dfa.states.size() );
+        b &= Test::TEST_EQUALS( (int) mappedNFA.size(),
+                                (int) nfa.states.size() );
+        b &= Test::TEST_EQUALS( mappedDFA.toDFA().finalStates ==
+                                dfa.finalStates, true );
+
+        std::set< char > alphabet = { 'a', 'b', 'c' };
+        bool agrees = true;
+        for( std::size_t n = 0; n < 7; ++n )
+            for( const std::vector<char>& w : tuple_range( alphabet, n ) ) {
+                bool expected = dfa.accepts( w.begin(), w.end() );
+                agrees &= mappedDFA.accepts( w.begin(), w.end() ) == expected;
+                agrees &= mappedNFA.accepts( w.begin(), w.end() ) == expected;
+            }
+        b &= Test::TEST_EQUALS( agrees, true );
+    }
+
+    // Arquivo vazio: nada é mapeado.
+    std::string emptyName = temporaryFile( "" );
+    {
+        MappedFile empty( emptyName );
+        b &= Test::TEST_EQUALS( (int) empty.size(), 0 );
+        empty.adviseSequential();
+        EXPECT_THROW( MappedDFA< char >( empty.data(), empty.size() ),
+                      serialization_error, b );
+    }
+
+    std::remove( dfaName.c_str() );
+    std::remove( nfaName.c_str() );
+    std::remove( emptyName.c_str() );
+    EXPECT_THROW( MappedFile{ dfaName }, std::system_error, b );
+
+    return b;
+}
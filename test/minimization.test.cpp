@@ -0,0 +1,43 @@
+/* minimization.test.cpp
+ * Teste de unidade para as funções de automaton/minimization.h.
+ */
+#include "automaton/minimization.h"
+
+#include "test/lib/test.h"
+
+DECLARE_TEST( MinimizationTest ) {
+    bool b = true;
+    // Autômato de Hopcroft, página 68.
+    DFA< int, char > dfa = { {0, 1, 2, 3, 4, 5, 6, 7},
+                             {'0', '1'},
+                             { {{0, '1'}, 5}, {{0, '0'}, 1},
+                               {{1, '1'}, 2}, {{1, '0'}, 6},
+                               {{2, '1'}, 2}, {{2, '0'}, 0},
+                               {{3, '1'}, 6}, {{3, '0'}, 2},
+                               {{4, '1'}, 5}, {{4, '0'}, 7},
+                               {{5, '1'}, 6}, {{5, '0'}, 2},
+                               {{6, '1'}, 4}, {{6, '0'}, 6},
+                               {{7, '1'}, 2}, {{7, '0'}, 6}
+                             },
+                             0,
+                             { 2 }
+    };
+    DFA< int, char > min = minimize( dfa );
+
+    b &= Test::TEST_EQUALS( (int) min.states.size(), 5 );
+    b &= Test::TEST_EQUALS( (int) min.finalStates.size(), 1 );
+    b &= Test::TEST_EQUALS( min.initialState, 0 );
+    // 4 é equivalente a 0, e 7 é equivalente a 1.
+    b &= Test::TEST_EQUALS( min.delta({6, '1'}), 0 );
+    b &= Test::TEST_EQUALS( min.delta({0, '0'}), 1 );
+    b &= Test::TEST_EQUALS( min.delta({5, '0'}), 2 );
+
+    /* Autômato com rótulos além de final/não-final: os estados 0 e 1
+     * seriam equivalentes, mas possuem rótulos diferentes. */
+    std::vector< int > delta = { 2, 2, 2 }; // Um único símbolo
+    std::vector< int > block = refinePartition( delta, 1, {0, 1, 0} );
+    b &= Test::TEST_EQUALS( block[0] == block[1], false );
+    b &= Test::TEST_EQUALS( block[0] == block[2], true );
+
+    return b;
+}
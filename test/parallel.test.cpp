@@ -0,0 +1,48 @@
+/* parallel.test.cpp
+ * Teste de unidade para as funções de automaton/parallel.h.
+ */
+#include "automaton/parallel.h"
+
+#include <string>
+#include <vector>
+#include "test/lib/test.h"
+
+DECLARE_TEST( ParallelAcceptsTest ) {
+    bool b = true;
+    DFA< int, char > dfa = { {0, 1, 2},
+                             {'a', 'b'},
+                             { {{0, 'a'}, 1}, {{0, 'b'}, 0},
+                               {{1, 'a'}, 1}, {{1, 'b'}, 2},
+                               {{2, 'a'}, 1}, {{2, 'b'}, 0}
+                             },
+                             0,
+                             {2}
+    }; // (a|b)*ab
+    DenseDFA< char > dense( dfa );
+    typedef DenseDFA< char >::State State;
+    const unsigned row = DenseDFA< char >::rowSize;
+
+    std::string s = "abba";
+    std::vector< State > mapping = chunkMapping( dense, s.begin(), s.end() );
+    b &= Test::TEST_EQUALS( (int) mapping.size(), 4 );
+    b &= Test::TEST_EQUALS( mapping[0] == DenseDFA< char >::dead, true );
+    for( unsigned q = 1; q < 4; ++q )
+        b &= Test::TEST_EQUALS( mapping[q] == 2 * row, true );
+
+    std::string text;
+    for( std::size_t i = 0; i < 4 * minimumParallelChunk + 7; ++i )
+        text += "aab"[i * 7 % 3];
+    for( unsigned threads : {0u, 1u, 2u, 3u, 4u} ) {
+        b &= Test::TEST_EQUALS(
+                parallelAccepts( dense, text.begin(), text.end(), threads ),
+                dense.accepts( text.begin(), text.end() ) );
+        b &= Test::TEST_EQUALS(
+                parallelAccepts( dense, text.begin(), text.end() - 1, threads ),
+                dense.accepts( text.begin(), text.end() - 1 ) );
+    }
+    text[3 * minimumParallelChunk] = 'c'; // Leva ao estado morto
+    b &= Test::TEST_EQUALS(
+            parallelAccepts( dense, text.begin(), text.end(), 4 ), false );
+
+    return b;
+}
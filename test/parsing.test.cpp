@@ -0,0 +1,64 @@
+/* parsing.test.cpp
+ * Teste de unidade para parse() e buildExpressionTree(), de
+ * regex/parsing.h.
+ */
+#include "regex/parsing.h"
+
+#include <string>
+#include "test/lib/test.h"
+
+DECLARE_TEST( ParsingTest ) {
+    bool b = true;
+    typedef BinaryTree< Either<char, Epsilon, Operator> > Tree;
+
+    // a|bc*:d é a | (b . (c* : d)).
+    Tree tree = parse( std::string( "a|bc*:d" ) );
+    auto root = tree.root();
+    b &= Test::TEST_EQUALS( *root == Operator::VerticalBar, true );
+    b &= Test::TEST_EQUALS( *root.leftChild() == 'a', true );
+    auto cat = root.rightChild();
+    b &= Test::TEST_EQUALS( *cat == Operator::Concatenation, true );
+    b &= Test::TEST_EQUALS( *cat.leftChild() == 'b', true );
+    auto sigma = cat.rightChild();
+    b &= Test::TEST_EQUALS( *sigma == Operator::SigmaClosure, true );
+    b &= Test::TEST_EQUALS( *sigma.leftChild() == Operator::KleneeClosure,
+                            true );
+    b &= Test::TEST_EQUALS( *sigma.leftChild().leftChild() == 'c', true );
+    b &= Test::TEST_EQUALS( *sigma.rightChild() == 'd', true );
+
+    /* Os vetores de tokens, com ou sem concatenações explícitas, geram
+     * a mesma árvore, nodo a nodo. */
+    std::string s = "(a\\|b)+.c?|&(d)";
+    Tree expected = parse( s );
+    auto v = tokenize( s.begin(), s.end() );
+    for( const Tree& t : { buildExpressionTree( v ),
+                      buildExpressionTree( explicitConcatenations( v ) ) } ) {
+        b &= Test::TEST_EQUALS( (int) t.raw().size(),
+                                (int) expected.raw().size() );
+        for( std::size_t i = 0; i < t.raw().size(); ++i ) {
+            b &= Test::TEST_EQUALS( (int) t.raw()[i].leftChild,
+                                    (int) expected.raw()[i].leftChild );
+            b &= Test::TEST_EQUALS( (int) t.raw()[i].rightChild,
+                                    (int) expected.raw()[i].rightChild );
+            b &= Test::TEST_EQUALS( t.raw()[i].data == expected.raw()[i].data,
+                                    true );
+        }
+    }
+
+    // Sem recursão, o aninhamento não é limitado pela pilha.
+    std::string deep = std::string( 100000, '(' ) + "a" +
+                       std::string( 100000, ')' ) + "*";
+    tree = parse( deep );
+    b &= Test::TEST_EQUALS( *tree.root() == Operator::KleneeClosure, true );
+    b &= Test::TEST_EQUALS( *tree.root().leftChild() == 'a', true );
+
+    EXPECT_THROW( parse( std::string( "" ) ), syntax_error, b );
+    EXPECT_THROW( parse( std::string( "a|" ) ), syntax_error, b );
+    EXPECT_THROW( parse( std::string( "(a" ) ), syntax_error, b );
+    EXPECT_THROW( parse( std::string( "a)" ) ), syntax_error, b );
+    EXPECT_THROW( parse( std::string( "()" ) ), syntax_error, b );
+    EXPECT_THROW( parse( std::string( "a|:b" ) ), syntax_error, b );
+    EXPECT_THROW( parse( std::string( "*a" ) ), syntax_error, b );
+
+    return b;
+}
@@ -0,0 +1,91 @@
+/* search.test.cpp
+ * Teste de unidade para a classe Searcher, de automaton/search.h.
+ */
+#include "automaton/search.h"
+
+#include <string>
+#include <vector>
+#include "algorithm/tuple_iterator.h"
+#include "regex/deSimone.h"
+#include "regex/parsing.h"
+#include "regex/thompson.h"
+#include "test/lib/countingIterator.h"
+#include "test/lib/test.h"
+
+/* Busca ingênua: testa cada intervalo do texto, a partir da posição
+ * atual, preferindo o início mais à esquerda e o fim mais à direita. */
+static std::vector< Span > naiveFindAll( const DFA< int, char >& dfa,
+                                         const std::vector< char >& text )
+{
+    std::vector< Span > spans;
+    std::size_t cursor = 0;
+    while( cursor <= text.size() ) {
+        bool found = false;
+        for( std::size_t i = cursor; i <= text.size() && !found; ++i )
+            for( std::size_t j = text.size() + 1; j-- > i; )
+                if( dfa.accepts( text.begin() + i, text.begin() + j ) ) {
+                    spans.push_back({ i, j });
+                    cursor = j > i ? j : i + 1;
+                    found = true;
+                    break;
+                }
+        if( !found )
+            break;
+    }
+    return spans;
+}
+
+DECLARE_TEST( SearcherTest ) {
+    bool b = true;
+
+    Searcher< char > s( thompson( parse( std::string( "ab*" ) ) ) );
+    std::string text = "xxabbbyaab";
+    Span match;
+    b &= Test::TEST_EQUALS( s.search( text.begin(), text.end(), match ), true );
+    b &= Test::TEST_EQUALS( (int) match.begin, 2 );
+    b &= Test::TEST_EQUALS( (int) match.end, 6 );
+    std::vector< Span > expected = { {2, 6}, {7, 8}, {8, 10} };
+    b &= Test::TEST_EQUALS( s.findAll( text.begin(), text.end() ) == expected,
+                            true );
+    text = "xyz";
+    b &= Test::TEST_EQUALS( s.search( text.begin(), text.end(), match ), false );
+
+    // Comparação com a busca ingênua, em todos os textos pequenos.
+    std::vector< std::string > regexes = { "(a|b)*abb", "ab|b*c", "&",
+        "a*", "(ab|a)(c|bcd)", "b(a|c)*b", "a|a*c", "(a|b)*c|a" };
+    std::set< char > alphabet = { 'a', 'b', 'c', 'd' };
+    for( const std::string& regex : regexes ) {
+        DFA< int, char > dfa = deSimone( parse( regex ) );
+        Searcher< char > searcher( thompson( parse( regex ) ) );
+        for( std::size_t n = 0; n < 6; ++n )
+            for( const std::vector<char>& w : tuple_range( alphabet, n ) )
+                b &= Test::TEST_EQUALS(
+                        searcher.findAll( w.begin(), w.end() ) ==
+                        naiveFindAll( dfa, w ), true );
+    }
+
+    /* Com L = a|a*c, num texto só com a, cada ocorrência tem tamanho 1,
+     * mas o autômato ancorado só morre no fim do texto; as leituras
+     * ancoradas não podem, ainda assim, custar tempo quadrático. */
+    std::vector< char > as( 20000, 'a' );
+    std::size_t reads = 0;
+    Searcher< char > munch( thompson( parse( std::string( "a|a*c" ) ) ) );
+    std::vector< Span > spans = munch.findAll(
+            CountingIterator( as.data(), &reads ),
+            CountingIterator( as.data() + as.size(), &reads ) );
+    b &= Test::TEST_EQUALS( (int) spans.size(), (int) as.size() );
+    Span last = { as.size() - 1, as.size() };
+    b &= Test::TEST_EQUALS( spans.back() == last, true );
+    b &= Test::TEST_EQUALS( reads <= 8 * as.size(), true );
+
+    // Cache pequena, esvaziada durante as leituras ancoradas.
+    std::string regex = "(a|b)*a(a|b)(a|b)(a|b)|b*c";
+    DFA< int, char > dfa = deSimone( parse( regex ) );
+    Searcher< char > small( thompson( parse( regex ) ), 1024 );
+    for( std::size_t n = 0; n < 8; ++n )
+        for( const std::vector<char>& w : tuple_range( alphabet, n ) )
+            b &= Test::TEST_EQUALS( small.findAll( w.begin(), w.end() ) ==
+                                    naiveFindAll( dfa, w ), true );
+
+    return b;
+}
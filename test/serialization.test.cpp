@@ -0,0 +1,99 @@
+/* serialization.test.cpp
+ * Teste de unidade para serialize, MappedDFA e MappedNFA, de
+ * automaton/serialization.h.
+ */
+#include "automaton/serialization.h"
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "conversion.h"
+#include "algorithm/tuple_iterator.h"
+#include "automaton/compaction.h"
+#include "automaton/minimization.h"
+#include "regex/parsing.h"
+#include "regex/thompson.h"
+#include "test/lib/test.h"
+
+template< typename D, typename I >
+bool sameFunction( const Math::Function< D, I >& f,
+                   const Math::Function< D, I >& g )
+{
+    return std::distance( f.begin(), f.end() ) ==
+           std::distance( g.begin(), g.end() ) &&
+           std::equal( f.begin(), f.end(), g.begin() );
+}
+
+DECLARE_TEST( SerializationTest ) {
+    bool b = true;
+    std::string regex = "(a|b)*abb:c";
+    DFA< int, char > dfa = compact( minimize( toCompactDFA(
+                thompson( parse( regex ) ) ) ) );
+    NFA< int, char > nfa = compact( toNFA( thompson( parse( regex ) ) ) );
+
+    std::ostringstream dfaStream, nfaStream;
+    serialize( dfa, dfaStream );
+    serialize( nfa, nfaStream );
+    std::string dfaData = dfaStream.str(), nfaData = nfaStream.str();
+
+    MappedDFA< char > mappedDFA( dfaData.data(), dfaData.size() );
+    MappedNFA< char > mappedNFA( nfaData.data(), nfaData.size() );
+    b &= Test::TEST_EQUALS( (int) mappedDFA.size(), (int) dfa.states.size() );
+    b &= Test::TEST_EQUALS( (int) mappedNFA.size(), (int) nfa.states.size() );
+
+    std::set< char > alphabet = { 'a', 'b', 'c', 'd' };
+    for( std::size_t n = 0; n < 7; ++n )
+        for( const std::vector<char>& w : tuple_range( alphabet, n ) ) {
+            bool expected = dfa.accepts( w.begin(), w.end() );
+            b &= Test::TEST_EQUALS( mappedDFA.accepts( w.begin(), w.end() ),
+                                    expected );
+            b &= Test::TEST_EQUALS( mappedNFA.accepts( w.begin(), w.end() ),
+                                    expected );
+        }
+
+    DFA< int, char > dfaCopy = mappedDFA.toDFA();
+    NFA< int, char > nfaCopy = mappedNFA.toNFA();
+    // Transições para o conjunto vazio não são gravadas.
+    Math::Function< std::pair<int, char>, std::set<int> > nonEmpty;
+    for( const auto& pair : nfa.delta )
+        if( !pair.second.empty() )
+            nonEmpty.insert( pair.first, pair.second );
+    b &= Test::TEST_EQUALS( dfaCopy.states == dfa.states &&
+                            dfaCopy.alphabet == dfa.alphabet &&
+                            sameFunction( dfaCopy.delta, dfa.delta ) &&
+                            dfaCopy.initialState == dfa.initialState &&
+                            dfaCopy.finalStates == dfa.finalStates, true );
+    b &= Test::TEST_EQUALS( nfaCopy.states == nfa.states &&
+                            sameFunction( nfaCopy.delta, nonEmpty ) &&
+                            nfaCopy.initialState == nfa.initialState &&
+                            nfaCopy.finalStates == nfa.finalStates, true );
+
+    // Símbolos maiores que um byte.
+    DFA< int, int > wide = { {0, 1}, {-5, 1000}, {{{0, -5}, 1}, {{1, 1000}, 0}},
+                             0, {1} };
+    std::ostringstream wideStream;
+    serialize( wide, wideStream );
+    std::string wideData = wideStream.str();
+    MappedDFA< int > mappedWide( wideData.data(), wideData.size() );
+    std::vector< int > w = { -5, 1000, -5 };
+    b &= Test::TEST_EQUALS( mappedWide.accepts( w.begin(), w.end() ), true );
+    w.pop_back();
+    b &= Test::TEST_EQUALS( mappedWide.accepts( w.begin(), w.end() ), false );
+
+    // Buffers inválidos.
+    EXPECT_THROW( MappedNFA< char >( dfaData.data(), dfaData.size() ),
+                  serialization_error, b );
+    EXPECT_THROW( MappedDFA< int >( dfaData.data(), dfaData.size() ),
+                  serialization_error, b );
+    EXPECT_THROW( MappedDFA< char >( dfaData.data(), dfaData.size() - 4 ),
+                  serialization_error, b );
+    std::string corrupted = dfaData;
+    corrupted[corrupted.size() - 1] ^= 1;
+    EXPECT_THROW( MappedDFA< char >( corrupted.data(), corrupted.size() ),
+                  serialization_error, b );
+    MappedDFA< char >( corrupted.data(), corrupted.size(), false );
+
+    return b;
+}
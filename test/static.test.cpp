@@ -0,0 +1,54 @@
+/* static.test.cpp
+ * Teste de unidade para a função staticDFA, de regex/static.h.
+ */
+#include "regex/static.h"
+
+#include <string>
+#include <vector>
+#include "algorithm/tuple_iterator.h"
+#include "regex/deSimone.h"
+#include "regex/parsing.h"
+#include "test/lib/test.h"
+
+// O autômato é construído e executado em tempo de compilação.
+constexpr auto abb = staticDFA( "(a|b)*abb" );
+static_assert( abb.accepts( "babb" ), "staticDFA must accept babb" );
+static_assert( !abb.accepts( "abba" ), "staticDFA must reject abba" );
+static_assert( !abb.accepts( "abbc" ), "staticDFA must reject abbc" );
+
+constexpr auto sigma = staticDFA< 16 >( "ab*c:d" );
+constexpr auto escaped = staticDFA( "\\(a\\)|&" );
+constexpr auto any = staticDFA( "(a|b|c|d)*" );
+
+template< std::size_t MaxStates >
+bool compare( const StaticDFA< MaxStates >& dfa, const std::string& regex ) {
+    bool b = true;
+    DFA< int, char > expected = deSimone( parse( regex ) );
+    std::set< char > alphabet = { 'a', 'b', 'c', 'd', '(' };
+    for( std::size_t n = 0; n < 6; ++n )
+        for( const std::vector<char>& w : tuple_range( alphabet, n ) )
+            b &= Test::TEST_EQUALS( dfa.accepts( w.begin(), w.end() ),
+                                    expected.accepts( w.begin(), w.end() ) );
+    return b;
+}
+
+DECLARE_TEST( StaticDFATest ) {
+    bool b = true;
+    b &= compare( abb, "(a|b)*abb" );
+    b &= compare( sigma, "ab*c:d" );
+    b &= compare( any, "(a|b|c|d)*" );
+    b &= Test::TEST_EQUALS( escaped.accepts( "(a)" ), true );
+    b &= Test::TEST_EQUALS( escaped.accepts( "" ), true );
+    b &= Test::TEST_EQUALS( escaped.accepts( "a" ), false );
+
+    // Avaliada em tempo de execução, staticDFA lança as exceções.
+    b &= compare( staticDFA( "(a|&)(b|&)" ), "(a|&)(b|&)" );
+    b &= compare( staticDFA( "(ab|a)*:b?" ), "(ab|a)*:b?" );
+    EXPECT_THROW( staticDFA( "a|" ), syntax_error, b );
+    EXPECT_THROW( staticDFA( "(a" ), syntax_error, b );
+    EXPECT_THROW( staticDFA( "a)" ), syntax_error, b );
+    EXPECT_THROW( staticDFA( "a||b" ), syntax_error, b );
+    EXPECT_THROW( staticDFA< 4 >( "(a|b)*abb" ), std::length_error, b );
+
+    return b;
+}
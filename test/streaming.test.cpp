@@ -0,0 +1,46 @@
+/* streaming.test.cpp
+ * Teste de unidade para a classe StreamMatcher, de automaton/streaming.h.
+ */
+#include "automaton/streaming.h"
+
+#include <string>
+#include "test/lib/test.h"
+
+DECLARE_TEST( StreamMatcherTest ) {
+    bool b = true;
+    DFA< int, char > dfa = { {0, 1, 2, 3},
+                             {'a', 'b', 'c'},
+                             { {{0, 'a'}, 1},
+                               {{1, 'a'}, 1}, {{1, 'b'}, 2}, {{1, 'c'}, 3},
+                               {{2, 'b'}, 2}, {{2, 'c'}, 3},
+                               {{3, 'a'}, 3}, {{3, 'b'}, 3}, {{3, 'c'}, 3}
+                             },
+                             0,
+                             {2}
+    }; // a+b+; 3 é um estado morto explícito
+    StreamMatcher< int, char > m( dfa );
+
+    b &= Test::TEST_EQUALS( m.feed( std::string( "aa" ) ), true );
+    b &= Test::TEST_EQUALS( m.accepting(), false );
+    b &= Test::TEST_EQUALS( m.feed( std::string( "ab" ) ), true );
+    b &= Test::TEST_EQUALS( m.accepting(), true );
+    b &= Test::TEST_EQUALS( m.feed( std::string( "" ) ), true );
+    b &= Test::TEST_EQUALS( m.feed( std::string( "bb" ) ), true );
+    b &= Test::TEST_EQUALS( (int) m.consumed(), 6 );
+    b &= Test::TEST_EQUALS( m.finish(), true );
+
+    // A próxima palavra começa do estado inicial.
+    b &= Test::TEST_EQUALS( (int) m.consumed(), 0 );
+    b &= Test::TEST_EQUALS( m.feed( std::string( "abcbb" ) ), false );
+    b &= Test::TEST_EQUALS( m.rejected(), true );
+    b &= Test::TEST_EQUALS( (int) m.consumed(), 3 );
+    b &= Test::TEST_EQUALS( m.feed( std::string( "b" ) ), false );
+    b &= Test::TEST_EQUALS( m.finish(), false );
+
+    b &= Test::TEST_EQUALS( m.feed( std::string( "b" ) ), false );
+    b &= Test::TEST_EQUALS( (int) m.consumed(), 1 );
+    m.reset();
+    b &= Test::TEST_EQUALS( m.rejected(), false );
+
+    return b;
+}
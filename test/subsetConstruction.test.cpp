@@ -0,0 +1,48 @@
+/* subsetConstruction.test.cpp
+ * Teste de unidade para toCompactDFA, de conversion.h.
+ */
+#include "conversion.h"
+
+#include <stdexcept>
+#include <string>
+#include "automaton/compaction.h"
+#include "automaton/decisionProcedures.h"
+#include "regex/parsing.h"
+#include "regex/thompson.h"
+#include "test/lib/test.h"
+
+DECLARE_TEST( SubsetConstructionTest ) {
+    bool b = true;
+    /* toCompactDFA deve produzir o mesmo autômato que toDFA, a menos
+     * da numeração dos estados. */
+    for( const char * regex : { "(a|b)*abb", "a:b", "(a|&)(b|c)*",
+                                "(a|b)*a(a|b)(a|b)(a|b)", "&" } ) {
+        NFAe< int, char > nfae = thompson( parse( std::string( regex ) ) );
+        NFA< int, char > nfa = toNFA( nfae );
+        DFA< int, char > expected = compact( toDFA( nfa ) );
+        DFA< int, char > dfa = toCompactDFA( nfa );
+        b &= Test::TEST_EQUALS( equivalent( dfa, expected ), true );
+        b &= Test::TEST_EQUALS( (int) dfa.states.size(),
+                                (int) expected.states.size() );
+        b &= Test::TEST_EQUALS( dfa.initialState, 0 );
+
+        // Sobrecarga para NFAe.
+        DFA< int, char > fromNFAe = toCompactDFA( nfae );
+        b &= Test::TEST_EQUALS( equivalent( fromNFAe, expected ), true );
+        b &= Test::TEST_EQUALS( (int) fromNFAe.states.size(),
+                                (int) expected.states.size() );
+    }
+
+    // Os estados precisam ser 0, 1, ..., n-1.
+    NFA< int, char > sparse;
+    sparse.states = {0, 2};
+    sparse.alphabet = {'a'};
+    sparse.delta.insert( {0, 'a'}, {2} );
+    sparse.initialState = 0;
+    sparse.finalStates = {2};
+    EXPECT_THROW( toCompactDFA( sparse ), std::domain_error, b );
+    sparse.states = {1, 2};
+    EXPECT_THROW( toCompactDFA( sparse ), std::domain_error, b );
+
+    return b;
+}
@@ -0,0 +1,48 @@
+/* thompson.test.cpp
+ * Teste de unidade para regex/thompson.h.
+ */
+#include "regex/thompson.h"
+
+#include <set>
+#include <string>
+#include "regex/parsing.h"
+#include "test/lib/test.h"
+
+DECLARE_TEST( ThompsonTest ) {
+    bool b = true;
+    /* c|ab: o filho esquerdo ocupa os estados 0 e 1; no filho direito, o
+     * estado inicial da concatenação (2) vem antes dos estados de a e b. */
+    NFAe< int, char > nfae = thompson( parse( std::string( "c|ab" ) ) );
+    b &= Test::TEST_EQUALS( (int) nfae.states.size(), 10 );
+    b &= Test::TEST_EQUALS( *nfae.states.rbegin(), 9 );
+    b &= Test::TEST_EQUALS( nfae.initialState, 8 );
+    b &= Test::TEST_EQUALS( nfae.finalStates == std::set<int>({9}), true );
+    b &= Test::TEST_EQUALS( nfae.alphabet == std::set<char>({'a', 'b', 'c'}),
+                            true );
+    b &= Test::TEST_EQUALS( nfae.delta({8, epsilon}) == std::set<int>({0, 2}),
+                            true );
+    b &= Test::TEST_EQUALS( nfae.delta({0, 'c'}) == std::set<int>({1}), true );
+    b &= Test::TEST_EQUALS( nfae.delta({2, epsilon}) == std::set<int>({3}),
+                            true );
+    b &= Test::TEST_EQUALS( nfae.delta({3, 'a'}) == std::set<int>({4}), true );
+    b &= Test::TEST_EQUALS( nfae.delta({4, epsilon}) == std::set<int>({5}),
+                            true );
+    b &= Test::TEST_EQUALS( nfae.delta({6, epsilon}) == std::set<int>({7}),
+                            true );
+    b &= Test::TEST_EQUALS( nfae.delta({7, epsilon}) == std::set<int>({9}),
+                            true );
+
+    // Opcional e fecho de Klenee: a?* possui apenas dois estados novos.
+    nfae = thompson( parse( std::string( "a?*" ) ) );
+    b &= Test::TEST_EQUALS( (int) nfae.states.size(), 4 );
+    b &= Test::TEST_EQUALS( nfae.delta({0, epsilon}) == std::set<int>({1}),
+                            true );
+    b &= Test::TEST_EQUALS( nfae.delta({2, epsilon}) == std::set<int>({0, 3}),
+                            true );
+
+    // Expressões longas: 2 estados por símbolo e por concatenação.
+    nfae = thompson( parse( std::string( 2000, 'a' ) ) );
+    b &= Test::TEST_EQUALS( (int) nfae.states.size(), 2 * 2000 + 2 * 1999 );
+
+    return b;
+}
@@ -0,0 +1,54 @@
+/* transitionsWithEpsilon.test.cpp
+ * Teste de unidade para automaton/transitionsWithEpsilon.h.
+ */
+#include "automaton/transitionsWithEpsilon.h"
+
+#include <set>
+#include <stdexcept>
+#include <vector>
+#include "test/lib/test.h"
+
+DECLARE_TEST( TransitionsWithEpsilonTest ) {
+    bool b = true;
+    TransitionsWithEpsilon< int, char > delta = { {{0, 'a'}, {1}},
+                                                  {{0, epsilon}, {2, 1}} };
+    delta.add( 0, epsilon, 3 );
+    delta.add( 0, epsilon, 2 );
+    delta.add( 1, 'a', 0 );
+    delta.add( 1, 'a', 2 );
+
+    // As listas de adjacência ficam ordenadas e sem repetições.
+    b &= Test::TEST_EQUALS( delta.epsilonSuccessors( 0 ) ==
+                            std::vector<int>({1, 2, 3}), true );
+    b &= Test::TEST_EQUALS( delta.epsilonSuccessors( 1 ).empty(), true );
+
+    // Interface de Math::Function.
+    b &= Test::TEST_EQUALS( delta({0, epsilon}) == std::set<int>({1, 2, 3}),
+                            true );
+    b &= Test::TEST_EQUALS( delta({1, 'a'}) == std::set<int>({0, 2}), true );
+    b &= Test::TEST_EQUALS( delta.onDomain({0, 'a'}), true );
+    b &= Test::TEST_EQUALS( delta.onDomain({1, epsilon}), false );
+    b &= Test::TEST_EQUALS( delta.onDomain({0, 'b'}), false );
+    EXPECT_THROW( delta({1, epsilon}), std::domain_error, b );
+
+    // Um conjunto vazio também pertence ao domínio.
+    delta.insert( {2, epsilon}, {} );
+    b &= Test::TEST_EQUALS( delta.onDomain({2, epsilon}), true );
+    delta.erase( {2, epsilon} );
+    b &= Test::TEST_EQUALS( delta.onDomain({2, epsilon}), false );
+
+    // A iteração percorre as transições por símbolo e depois as épsilon.
+    int count = 0, epsilons = 0;
+    for( const auto& pair : delta ) {
+        b &= Test::TEST_EQUALS( delta( pair.first ) == pair.second, true );
+        ++count;
+        if( pair.first.second.is< Epsilon >() )
+            ++epsilons;
+        else
+            b &= Test::TEST_EQUALS( epsilons, 0 );
+    }
+    b &= Test::TEST_EQUALS( count, 3 );
+    b &= Test::TEST_EQUALS( epsilons, 1 );
+
+    return b;
+}
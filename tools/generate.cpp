@@ -0,0 +1,71 @@
+/* generate.cpp
+ * Ferramenta de linha de comando que gera uma função C++ especializada
+ * para reconhecer a linguagem de uma expressão regular.
+ *
+ * Uso:
+ *  generate [opções] expressão
+ *
+ * Opções:
+ *  -d        Usa o algoritmo de De Simone, em vez do algoritmo de Thompson.
+ *  -n nome   Nome da função gerada (padrão: "match").
+ *
+ * A expressão é compilada para o DFA mínimo compacto, como em tools/scan,
+ * e a função gerada por generateMatcher (automaton/codeGeneration.h) é
+ * escrita na saída padrão, como um cabeçalho que pode ser incluído
+ * diretamente.
+ */
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <string>
+#include "conversion.h"
+#include "automaton/codeGeneration.h"
+#include "automaton/compaction.h"
+#include "automaton/minimization.h"
+#include "regex/deSimone.h"
+#include "regex/parsing.h"
+#include "regex/thompson.h"
+
+int main( int argc, char ** argv ) {
+    bool useDeSimone = false;
+    std::string name = "match";
+    int i = 1;
+    for( ; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; ++i ) {
+        std::string option = argv[i];
+        if( option == "-d" )
+            useDeSimone = true;
+        else if( option == "-n" && i + 1 < argc )
+            name = argv[++i];
+        else
+            break;
+    }
+    if( argc - i != 1 ) {
+        std::fprintf( stderr, "Usage: generate [-d] [-n name] regex\n" );
+        return 2;
+    }
+    std::string regex = argv[i];
+
+    DFA< int, char > dfa;
+    try {
+        if( useDeSimone )
+            dfa = compact( minimize( deSimone( parse( regex ) ) ) );
+        else
+            dfa = compact( minimize( toCompactDFA( thompson( parse( regex ) ) ) ) );
+    } catch( std::exception& e ) {
+        std::fprintf( stderr, "generate: invalid regex '%s': %s\n",
+                      regex.c_str(), e.what() );
+        return 2;
+    }
+
+    // A expressão não pode fechar o comentário.
+    std::string comment = regex;
+    for( std::size_t j = comment.find( "*/" ); j != std::string::npos;
+                     j = comment.find( "*/", j ) )
+        comment.insert( j + 1, " " );
+
+    std::cout << "/* Gerado por tools/generate a partir da expressão\n"
+              << " *  " << comment << "\n"
+              << " * DFA mínimo: " << dfa.states.size() << " estado(s). */\n";
+    generateMatcher( dfa, name, std::cout );
+    return 0;
+}
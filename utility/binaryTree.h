@@ -6,12 +6,14 @@
  * interno.
  *
  * Uma peculiariedade desta classe é o fato de a deleção de um elemento
- * da árvore ser "preguiçosa": o elemento só é deletado de fato quando
- * um elemento novo seja inserido. E, neste caso, ele não é deletado: 
- * o operador de atribuição do elemento é utilizado para subsituir o antigo,
- * que não está sendo usado, pelo que acaba de ser inserido.
+ * da árvore ser "preguiçosa": o espaço do nodo deletado continua no
+ * vetor, numa lista de espaços livres, e só é reaproveitado quando um
+ * elemento novo é inserido. Neste caso, o operador de atribuição do
+ * elemento é utilizado para substituir o antigo pelo que acaba de ser
+ * inserido.
  *
- * TODO: na verdade, nada é deletado; a deleção não foi implementada.
+ * Após muitas remoções, os nodos restantes podem estar espalhados pelo
+ * vetor; compact() renumera-os em pré-ordem e libera os espaços livres.
  */
 #ifndef BINARY_TREE_H
 #define BINARY_TREE_H
@@ -196,6 +198,27 @@ public:
     /* Retorna o vetor de nodos desta árvore. */
     const std::vector<node>& raw() const;
 
+    /* Reserva espaço para n nodos no vetor interno, evitando realocações
+     * enquanto a árvore tiver no máximo n nodos. */
+    void reserve( std::size_t n );
+
+    /* Renumera os nodos acessíveis a partir da raiz em pré-ordem, de
+     * modo que cada subárvore ocupe um trecho contíguo do vetor, e
+     * descarta os demais espaços. Costuras (veja algorithm/trees.h)
+     * são preservadas.
+     *
+     * Todos os iteradores para a árvore são invalidados, exceto os que
+     * apontam para a raiz. */
+    void compact();
+
+    /* Quantidade de nodos em uso, e quantidade de espaços no vetor
+     * interno (nodos em uso e espaços livres). */
+    std::size_t size() const;
+    std::size_t slots() const;
+
+    /* Fração dos espaços do vetor interno ocupada por nodos em uso. */
+    double liveRatio() const;
+
 private: // Métodos usados internamente
     /* Cria um novo nodo na árvore para ser o filho da esquerda
      * (direita) do nó no índice especificado.
@@ -218,10 +241,20 @@ private: // Métodos usados internamente
     void collapseRight( Index );
 
     /* Destrói o nodo passado na primeira versão, e o nodo passado
-     * e todos os subnós na segunda versão.
-     * FIXME: a função destrói nada, na verdade. */
+     * e todos os subnós na segunda versão. Os espaços são colocados
+     * na lista de espaços livres. */
     void destroy( Index );
     void recursivelyDestroy( Index );
+
+    /* Insere o nodo passado num espaço livre, se houver, ou no fim do
+     * vetor, e retorna o seu índice. */
+    Index allocate( const node& );
+
+    /* Informa se child é filho de fato do nodo index, e não uma
+     * costura ou o nodo nulo. */
+    bool isChild( Index index, Index child ) const;
+
+    std::vector< Index > freeSlots;
 };
 
 // Implementação
@@ -271,16 +304,21 @@ auto BinaryTree<T, Index>::raw() const -> const std::vector<node>& {
     return nodes;
 }
 
+template< typename T, typename Index >
+void BinaryTree<T, Index>::reserve( std::size_t n ) {
+    nodes.reserve( n );
+}
+
 // BinaryTree - criação de filhos
 template< typename T, typename Index >
 void BinaryTree<T, Index>::makeLeftChild( Index index ) {
-    nodes[index].leftChild = nodes.size();
-    nodes.push_back({ index, node::null, node::null, T() });
+    Index childIndex = allocate({ index, node::null, node::null, T() });
+    nodes[index].leftChild = childIndex;
 }
 template< typename T, typename Index >
 void BinaryTree<T, Index>::makeRightChild( Index index ) {
-    nodes[index].rightChild = nodes.size();
-    nodes.push_back({ index, node::null, node::null, T() });
+    Index childIndex = allocate({ index, node::null, node::null, T() });
+    nodes[index].rightChild = childIndex;
 }
 
 // BinaryTree - ascensão
@@ -288,15 +326,18 @@ template< typename T, typename Index >
 void BinaryTree<T, Index>::leftAscent( Index index ) {
     /* Copiaremos o nó atual para um novo lugar
      * e promoveremos o atual para pai da cópia. */
-    Index childIndex = nodes.size();
-    nodes.push_back( nodes[index] );
+    Index childIndex = allocate( nodes[index] );
 
     // Corrigir os filhos do nodo pai
     nodes[index].rightChild = childIndex;
     nodes[index].leftChild = node::null;
 
-    // Corrigir o pai do nodo filho
+    // Corrigir o pai do nodo filho, e o pai dos filhos deste
     nodes[childIndex].parent = index;
+    if( isChild( index, nodes[childIndex].leftChild ) )
+        nodes[nodes[childIndex].leftChild].parent = childIndex;
+    if( isChild( index, nodes[childIndex].rightChild ) )
+        nodes[nodes[childIndex].rightChild].parent = childIndex;
 
     /* Note que, como o nodo que ascendeu continou no mesmo
      * lugar, o nodo zero será sempre o nodo raíz. */
@@ -304,13 +345,16 @@ void BinaryTree<T, Index>::leftAscent( Index index ) {
 
 template< typename T, typename Index >
 void BinaryTree<T, Index>::rightAscent( Index index ) {
-    Index childIndex = nodes.size();
-    nodes.push_back( nodes[index] );
+    Index childIndex = allocate( nodes[index] );
 
     nodes[index].leftChild = childIndex;
     nodes[index].rightChild = node::null;
 
     nodes[childIndex].parent = index;
+    if( isChild( index, nodes[childIndex].leftChild ) )
+        nodes[nodes[childIndex].leftChild].parent = childIndex;
+    if( isChild( index, nodes[childIndex].rightChild ) )
+        nodes[nodes[childIndex].rightChild].parent = childIndex;
 }
 
 // BinaryTree - queda (colapso)
@@ -323,43 +367,125 @@ void BinaryTree<T, Index>::collapseLeft( Index index ) {
      * pais trocados de lugar. */
     Index parentIndex = nodes[index].parent;
     Index childIndex = nodes[index].leftChild;
-    if( nodes[index].rightChild != node::null )
+    if( isChild( index, nodes[index].rightChild ) )
         recursivelyDestroy( nodes[index].rightChild );
 
     nodes[index] = nodes[childIndex];
     nodes[index].parent = parentIndex;
-    destroy( childIndex );
-    if( nodes[index].leftChild != node::null )
+    if( isChild( childIndex, nodes[index].leftChild ) )
         nodes[nodes[index].leftChild].parent = index;
-    if( nodes[index].rightChild != node::null )
+    if( isChild( childIndex, nodes[index].rightChild ) )
         nodes[nodes[index].rightChild].parent = index;
+    destroy( childIndex );
 }
 
 template< typename T, typename Index >
 void BinaryTree<T, Index>::collapseRight( Index index ) {
     Index parentIndex = nodes[index].parent;
     Index childIndex = nodes[index].rightChild;
-    if( nodes[index].leftChild != node::null )
+    if( isChild( index, nodes[index].leftChild ) )
         recursivelyDestroy( nodes[index].leftChild );
 
     nodes[index] = nodes[childIndex];
     nodes[index].parent = parentIndex;
-    destroy( childIndex );
-    if( nodes[index].leftChild != node::null )
+    if( isChild( childIndex, nodes[index].leftChild ) )
         nodes[nodes[index].leftChild].parent = index;
-    if( nodes[index].rightChild != node::null )
+    if( isChild( childIndex, nodes[index].rightChild ) )
         nodes[nodes[index].rightChild].parent = index;
+    destroy( childIndex );
 }
 
 // BinaryTree - destruição
 template< typename T, typename Index >
 void BinaryTree<T, Index>::destroy( Index index ) {
-    // FIXME: nada é feito para recuperar a memória perdida
+    // O valor é substituído para liberar os recursos que ele possua.
+    nodes[index] = { node::null, node::null, node::null, T() };
+    freeSlots.push_back( index );
 }
 
 template< typename T, typename Index >
 void BinaryTree<T, Index>::recursivelyDestroy( Index index ) {
-    // FIXME: nada é feito para recuperar a memória perdida
+    /* Apenas os filhos de fato são destruídos; as costuras apontam para
+     * nodos fora da subárvore. */
+    std::vector< Index > stack( 1, index );
+    while( !stack.empty() ) {
+        Index i = stack.back();
+        stack.pop_back();
+        if( isChild( i, nodes[i].leftChild ) )
+            stack.push_back( nodes[i].leftChild );
+        if( isChild( i, nodes[i].rightChild ) )
+            stack.push_back( nodes[i].rightChild );
+        destroy( i );
+    }
+}
+
+template< typename T, typename Index >
+Index BinaryTree<T, Index>::allocate( const node& n ) {
+    if( freeSlots.empty() ) {
+        nodes.push_back( n );
+        return nodes.size() - 1;
+    }
+    Index index = freeSlots.back();
+    freeSlots.pop_back();
+    nodes[index] = n;
+    return index;
+}
+
+template< typename T, typename Index >
+bool BinaryTree<T, Index>::isChild( Index index, Index child ) const {
+    return child != node::null && nodes[child].parent == index;
+}
+
+// BinaryTree - compactação e estatísticas
+template< typename T, typename Index >
+void BinaryTree<T, Index>::compact() {
+    /* Primeira passada: numeração em pré-ordem, seguindo apenas os
+     * filhos de fato. Os espaços livres e os nodos inacessíveis ficam
+     * com o número nulo. */
+    std::vector< Index > number( nodes.size(), Index( node::null ) );
+    std::vector< Index > order;
+    order.reserve( size() );
+    std::vector< Index > stack( 1, 0 );
+    while( !stack.empty() ) {
+        Index i = stack.back();
+        stack.pop_back();
+        number[i] = order.size();
+        order.push_back( i );
+        if( isChild( i, nodes[i].rightChild ) )
+            stack.push_back( nodes[i].rightChild );
+        if( isChild( i, nodes[i].leftChild ) )
+            stack.push_back( nodes[i].leftChild );
+    }
+
+    // Segunda passada: cópia dos nodos, com os índices renumerados.
+    auto renumber = [&]( Index i ) {
+        return i == node::null ? node::null : number[i];
+    };
+    std::vector< node > compacted;
+    compacted.reserve( order.size() );
+    for( Index i : order ) {
+        node& n = nodes[i];
+        compacted.push_back({ renumber( n.parent ), renumber( n.leftChild ),
+                              renumber( n.rightChild ), std::move( n.data ) });
+    }
+    nodes.swap( compacted );
+    freeSlots.clear();
+    freeSlots.shrink_to_fit();
+}
+
+template< typename T, typename Index >
+std::size_t BinaryTree<T, Index>::size() const {
+    return nodes.size() - freeSlots.size();
+}
+
+template< typename T, typename Index >
+std::size_t BinaryTree<T, Index>::slots() const {
+    return nodes.size();
+}
+
+template< typename T, typename Index >
+double BinaryTree<T, Index>::liveRatio() const {
+    return double( size() ) / slots();
 }
 
 
@@ -429,17 +555,17 @@ void BinaryTree<T, Index>::iterator::collapseRight() {
 // Destruir subárvores
 template< typename T, typename Index >
 void BinaryTree<T, Index>::iterator::destroyLeftSubtree() {
-    if( tree->nodes[index].leftChild != node::null ) {
+    // Costuras são apenas desfeitas.
+    if( tree->isChild( index, tree->nodes[index].leftChild ) )
         tree->recursivelyDestroy( tree->nodes[index].leftChild );
-        tree->nodes[index].leftChild = node::null;
-    }
+    tree->nodes[index].leftChild = node::null;
 }
 template< typename T, typename Index >
 void BinaryTree<T, Index>::iterator::destroyRightSubtree() {
-    if( tree->nodes[index].rightChild != node::null ) {
+    // Costuras são apenas desfeitas.
+    if( tree->isChild( index, tree->nodes[index].rightChild ) )
         tree->recursivelyDestroy( tree->nodes[index].rightChild );
-        tree->nodes[index].rightChild = node::null;
-    }
+    tree->nodes[index].rightChild = node::null;
 }
 
 // Alterar "ponteiros"
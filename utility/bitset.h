@@ -0,0 +1,179 @@
+/* bitset.h
+ * Conjunto de inteiros representado por um mapa de bits de tamanho
+ * decidido em tempo de execução.
+ *
+ * Algoritmos como a construção de subconjuntos manipulam muitos
+ * conjuntos de estados; se os estados forem os inteiros 0, 1, ..., n-1
+ * (como em autômatos compactos), cada conjunto pode ser armazenado em
+ * n bits, divididos em palavras de 64 bits. União, interseção,
+ * comparação e hashing custam, então, O(n/64).
+ *
+ * Todos os operadores binários exigem que os dois conjuntos tenham
+ * o mesmo tamanho.
+ */
+#ifndef BITSET_H
+#define BITSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Bitset {
+    std::vector< std::uint64_t > words;
+    std::size_t bits = 0;
+
+public:
+    /* Constrói um conjunto vazio, sobre o universo {0, 1, ..., n-1}. */
+    Bitset() = default;
+    explicit Bitset( std::size_t n );
+
+    /* Tamanho do universo (não a quantidade de elementos). */
+    std::size_t size() const;
+
+    /* Testa, adiciona e remove o elemento passado. */
+    bool test( std::size_t ) const;
+    void set( std::size_t );
+    void reset( std::size_t );
+
+    /* Remove todos os elementos do conjunto. */
+    void clear();
+
+    /* Informa se o conjunto é vazio, e a quantidade de elementos. */
+    bool none() const;
+    std::size_t count() const;
+
+    /* União e interseção. */
+    Bitset& operator|=( const Bitset& );
+    Bitset& operator&=( const Bitset& );
+
+    /* Informa se os conjuntos possuem algum elemento em comum,
+     * e se este conjunto está contido no passado. */
+    bool intersects( const Bitset& ) const;
+    bool isSubsetOf( const Bitset& ) const;
+
+    /* Executa f(i) para cada elemento i do conjunto, em ordem crescente. */
+    template< typename F >
+    void forEach( F f ) const;
+
+    /* Valor de hash do conjunto; veja também BitsetHash. */
+    std::size_t hash() const;
+
+    /* Acesso às palavras internas, para algoritmos que precisem
+     * manipular o conjunto diretamente. */
+    const std::vector< std::uint64_t >& raw() const;
+
+    friend bool operator==( const Bitset&, const Bitset& );
+    friend bool operator<( const Bitset&, const Bitset& );
+};
+
+inline bool operator!=( const Bitset&, const Bitset& );
+
+/* Função de hash, para uso em std::unordered_map e std::unordered_set. */
+struct BitsetHash {
+    std::size_t operator()( const Bitset& b ) const {
+        return b.hash();
+    }
+};
+
+// Implementação
+
+inline Bitset::Bitset( std::size_t n ) :
+    words( (n + 63) / 64, 0 ),
+    bits( n )
+{}
+
+inline std::size_t Bitset::size() const {
+    return bits;
+}
+
+inline bool Bitset::test( std::size_t i ) const {
+    return (words[i / 64] >> (i % 64)) & 1;
+}
+
+inline void Bitset::set( std::size_t i ) {
+    words[i / 64] |= std::uint64_t(1) << (i % 64);
+}
+
+inline void Bitset::reset( std::size_t i ) {
+    words[i / 64] &= ~(std::uint64_t(1) << (i % 64));
+}
+
+inline void Bitset::clear() {
+    for( std::uint64_t& w : words )
+        w = 0;
+}
+
+inline bool Bitset::none() const {
+    for( std::uint64_t w : words )
+        if( w != 0 )
+            return false;
+    return true;
+}
+
+inline std::size_t Bitset::count() const {
+    std::size_t c = 0;
+    for( std::uint64_t w : words )
+        c += __builtin_popcountll( w );
+    return c;
+}
+
+inline Bitset& Bitset::operator|=( const Bitset& b ) {
+    for( std::size_t i = 0; i < words.size(); ++i )
+        words[i] |= b.words[i];
+    return *this;
+}
+
+inline Bitset& Bitset::operator&=( const Bitset& b ) {
+    for( std::size_t i = 0; i < words.size(); ++i )
+        words[i] &= b.words[i];
+    return *this;
+}
+
+inline bool Bitset::intersects( const Bitset& b ) const {
+    for( std::size_t i = 0; i < words.size(); ++i )
+        if( words[i] & b.words[i] )
+            return true;
+    return false;
+}
+
+inline bool Bitset::isSubsetOf( const Bitset& b ) const {
+    for( std::size_t i = 0; i < words.size(); ++i )
+        if( words[i] & ~b.words[i] )
+            return false;
+    return true;
+}
+
+template< typename F >
+void Bitset::forEach( F f ) const {
+    for( std::size_t i = 0; i < words.size(); ++i )
+        for( std::uint64_t w = words[i]; w != 0; w &= w - 1 )
+            f( i * 64 + __builtin_ctzll( w ) );
+}
+
+inline std::size_t Bitset::hash() const {
+    // FNV-1a, aplicado palavra a palavra.
+    std::uint64_t h = 14695981039346656037ull;
+    for( std::uint64_t w : words ) {
+        h ^= w;
+        h *= 1099511628211ull;
+    }
+    return h ^ (h >> 32);
+}
+
+inline const std::vector< std::uint64_t >& Bitset::raw() const {
+    return words;
+}
+
+inline bool operator==( const Bitset& lhs, const Bitset& rhs ) {
+    return lhs.words == rhs.words;
+}
+
+inline bool operator!=( const Bitset& lhs, const Bitset& rhs ) {
+    return !(lhs == rhs);
+}
+
+inline bool operator<( const Bitset& lhs, const Bitset& rhs ) {
+    return lhs.words < rhs.words;
+}
+
+#endif // BITSET_H
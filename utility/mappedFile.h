@@ -0,0 +1,89 @@
+/* mappedFile.h
+ * Arquivo mapeado em memória, somente para leitura.
+ *
+ * O mapeamento é compartilhado pelo sistema operacional: processos que
+ * mapeiam o mesmo arquivo usam as mesmas páginas, que são lidas do disco
+ * apenas quando acessadas pela primeira vez.
+ */
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+class MappedFile {
+public:
+    /* Mapeia o arquivo passado.
+     *
+     * Exceção lançada:
+     *  std::system_error - caso o arquivo não possa ser aberto ou mapeado. */
+    explicit MappedFile( const std::string& path );
+    ~MappedFile();
+
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+
+    /* Conteúdo do arquivo; data() é alinhado ao tamanho da página. */
+    const void * data() const;
+    std::size_t size() const;
+
+    /* Indica ao sistema operacional que o arquivo será lido em ordem,
+     * para que as páginas seguintes sejam lidas antecipadamente. */
+    void adviseSequential() const;
+
+private:
+    void * map;
+    std::size_t length;
+};
+
+// Implementação
+
+inline MappedFile::MappedFile( const std::string& path ) :
+    map( nullptr ),
+    length( 0 )
+{
+    int fd = open( path.c_str(), O_RDONLY );
+    struct stat info;
+    if( fd == -1 || fstat( fd, &info ) == -1 ) {
+        int error = errno;
+        if( fd != -1 )
+            close( fd );
+        throw std::system_error( error, std::generic_category(), path );
+    }
+    length = info.st_size;
+    if( length > 0 ) {
+        map = mmap( nullptr, length, PROT_READ, MAP_SHARED, fd, 0 );
+        if( map == MAP_FAILED ) {
+            int error = errno;
+            close( fd );
+            throw std::system_error( error, std::generic_category(), path );
+        }
+    }
+    close( fd ); // O mapeamento continua válido sem o descritor.
+}
+
+inline MappedFile::~MappedFile() {
+    if( length > 0 )
+        munmap( map, length );
+}
+
+inline const void * MappedFile::data() const {
+    return map;
+}
+
+inline std::size_t MappedFile::size() const {
+    return length;
+}
+
+inline void MappedFile::adviseSequential() const {
+    if( length > 0 )
+        madvise( map, length, MADV_SEQUENTIAL );
+}
+
+#endif // MAPPED_FILE_H
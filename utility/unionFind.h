@@ -0,0 +1,67 @@
+/* unionFind.h
+ * Partição dos inteiros 0, 1, ..., n-1 em classes disjuntas, com
+ * união de classes e consulta do representante (union-find).
+ *
+ * Com compressão de caminhos e união por tamanho, uma sequência de m
+ * operações custa O(m α(n)), em que α é a inversa da função de
+ * Ackermann.
+ */
+#ifndef UNION_FIND_H
+#define UNION_FIND_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+class UnionFind {
+    std::vector< int > parent;
+    std::vector< int > size;
+
+public:
+    /* Constrói a partição em que cada elemento está sozinho na classe. */
+    UnionFind() = default;
+    explicit UnionFind( std::size_t n );
+
+    /* Representante da classe do elemento passado. */
+    int find( int );
+
+    /* Une as classes dos dois elementos. Retorna false caso eles já
+     * estivessem na mesma classe. */
+    bool unite( int, int );
+};
+
+// Implementação
+
+inline UnionFind::UnionFind( std::size_t n ) :
+    parent( n ),
+    size( n, 1 )
+{
+    for( std::size_t i = 0; i < n; ++i )
+        parent[i] = i;
+}
+
+inline int UnionFind::find( int x ) {
+    int root = x;
+    while( parent[root] != root )
+        root = parent[root];
+    while( parent[x] != root ) {
+        int next = parent[x];
+        parent[x] = root;
+        x = next;
+    }
+    return root;
+}
+
+inline bool UnionFind::unite( int x, int y ) {
+    x = find( x );
+    y = find( y );
+    if( x == y )
+        return false;
+    if( size[x] < size[y] )
+        std::swap( x, y );
+    parent[y] = x;
+    size[x] += size[y];
+    return true;
+}
+
+#endif // UNION_FIND_H